@@ -0,0 +1,200 @@
+#include <stdlib.h>     // Para realloc, free
+#include <string.h>     // Para memcpy, memset
+#include "extent.h"     // Cabecera con EXT_BLOCK, Extent, ExtFile
+
+#define EXT_MIN_BLOCKS 64   // Capacidad mínima del almacén (múltiplo de 64)
+
+// ======================================================
+// 📌 Variables globales
+// ======================================================
+static unsigned char *store = NULL;       // Bytes de todos los bloques
+static unsigned long long *bitmap = NULL; // Un bit por bloque (1 = en uso)
+static int store_blocks = 0;              // Bloques reservados
+static int used_blocks = 0;               // Bloques en uso
+static int low_free = 0;                  // No hay bloques libres por debajo
+
+// ======================================================
+// 📌 Almacén de bloques
+// ======================================================
+
+static int bit_get(int b) { return (int)((bitmap[b >> 6] >> (b & 63)) & 1); }
+static void bit_set(int b) { bitmap[b >> 6] |= 1ULL << (b & 63); }
+static void bit_clear(int b) { bitmap[b >> 6] &= ~(1ULL << (b & 63)); }
+
+// Cambia la capacidad del almacén (múltiplo de 64 bloques)
+static int store_resize(int nblocks) {
+    unsigned char *ns = realloc(store, (size_t)nblocks * EXT_BLOCK);
+    if (!ns) return -1;
+    store = ns;
+    unsigned long long *nb = realloc(bitmap, (size_t)(nblocks / 64) * sizeof(unsigned long long));
+    if (nb) bitmap = nb;
+    else if (nblocks > store_blocks) return -1;  // Al achicar, el bitmap viejo sirve
+    for (int w = store_blocks / 64; w < nblocks / 64; ++w) bitmap[w] = 0;
+    store_blocks = nblocks;
+    return 0;
+}
+
+// Primer bloque libre desde 'from' (palabra a palabra). -1 si no hay
+static int find_free(int from) {
+    for (int w = from >> 6; w < store_blocks / 64; ++w) {
+        unsigned long long used = bitmap[w];
+        if (w == from >> 6) used |= (1ULL << (from & 63)) - 1;  // Ignora los anteriores
+        if (~used) return w * 64 + __builtin_ctzll(~used);
+    }
+    return -1;
+}
+
+// Reserva hasta 'want' bloques contiguos, empezando en 'hint' si está
+// libre (para extender un extent en el lugar). Devuelve el primero y
+// en *got cuántos; -1 sin memoria
+static int alloc_run(int want, int hint, int *got) {
+    int start = (hint >= 0 && hint < store_blocks && !bit_get(hint)) ? hint : find_free(low_free);
+    if (start == -1) {
+        // Almacén lleno: duplicarlo; lo nuevo empieza libre
+        int old = store_blocks;
+        int ncap = old ? old * 2 : EXT_MIN_BLOCKS;
+        while (ncap - old < want && ncap < (1 << 30)) ncap *= 2;
+        if (store_resize(ncap) == -1) return -1;
+        start = old;
+    }
+    int n = 0;
+    while (n < want && start + n < store_blocks && !bit_get(start + n)) bit_set(start + n++);
+    used_blocks += n;
+    if (start == low_free) low_free = start + n;
+    *got = n;
+    return start;
+}
+
+// Devuelve un tramo al almacén y lo achica si la mitad alta quedó libre
+static void free_run(int start, int count) {
+    for (int b = start; b < start + count; ++b) bit_clear(b);
+    used_blocks -= count;
+    if (start < low_free) low_free = start;
+
+    while (store_blocks > EXT_MIN_BLOCKS && used_blocks < store_blocks / 4) {
+        int half = store_blocks / 2;
+        for (int w = half / 64; w < store_blocks / 64; ++w)
+            if (bitmap[w]) return;   // Quedan bloques en uso arriba
+        if (store_resize(half) == -1) return;
+    }
+}
+
+void ext_store_stats(long long *used, long long *total) {
+    *used = used_blocks;
+    *total = store_blocks;
+}
+
+// ======================================================
+// 📌 Archivos
+// ======================================================
+
+void ext_init(ExtFile *f) {
+    f->ext = NULL;
+    f->len = f->cap = 0;
+    f->blocks = 0;
+    f->size = 0;
+}
+
+// Devuelve los bloques por encima de los necesarios para 'size' bytes
+static void trim_blocks(ExtFile *f, long long size) {
+    int need = (int)((size + EXT_BLOCK - 1) / EXT_BLOCK);
+    while (f->blocks > need) {
+        Extent *last = &f->ext[f->len - 1];
+        int drop = f->blocks - need < last->count ? f->blocks - need : last->count;
+        free_run(last->start + last->count - drop, drop);
+        last->count -= drop;
+        f->blocks -= drop;
+        if (last->count == 0) f->len--;
+    }
+}
+
+// Asigna bloques hasta cubrir 'bytes'. Devuelve 0 o -1
+static int reserve(ExtFile *f, long long bytes) {
+    int need = (int)((bytes + EXT_BLOCK - 1) / EXT_BLOCK);
+    while (f->blocks < need) {
+        int hint = f->len ? f->ext[f->len - 1].start + f->ext[f->len - 1].count : -1;
+        int got;
+        int start = alloc_run(need - f->blocks, hint, &got);
+        if (start == -1) { trim_blocks(f, f->size); return -1; }
+        if (start == hint) {
+            f->ext[f->len - 1].count += got;   // Extiende el último extent en el lugar
+        } else {
+            if (f->len == f->cap) {
+                int ncap = f->cap ? f->cap * 2 : 4;
+                Extent *ne = realloc(f->ext, (size_t)ncap * sizeof(Extent));
+                if (!ne) { free_run(start, got); trim_blocks(f, f->size); return -1; }
+                f->ext = ne;
+                f->cap = ncap;
+            }
+            f->ext[f->len].start = start;
+            f->ext[f->len].count = got;
+            f->len++;
+        }
+        f->blocks += got;
+    }
+    return 0;
+}
+
+// Recorre [off, off + n) extent por extent: copia hacia 'buf'
+// (lectura), desde 'buf' (escritura) o pone ceros (buf == NULL).
+// El extent inicial se busca desde el extremo más cercano, así un
+// agregado al final solo visita los últimos extents
+static void walk(const ExtFile *f, long long off, long long n, unsigned char *buf, int write) {
+    int e = 0;
+    long long base = 0;   // Desplazamiento del extent actual dentro del archivo
+    if (off >= (long long)f->blocks * EXT_BLOCK / 2) {
+        base = (long long)f->blocks * EXT_BLOCK;
+        for (e = f->len - 1; e > 0; --e) {
+            base -= (long long)f->ext[e].count * EXT_BLOCK;
+            if (base <= off) break;
+        }
+        if (e == 0) base = 0;
+    }
+    for (; e < f->len && n > 0; ++e) {
+        long long len = (long long)f->ext[e].count * EXT_BLOCK;
+        if (off >= base + len) { base += len; continue; }
+        unsigned char *p = store + (long long)f->ext[e].start * EXT_BLOCK + (off - base);
+        long long chunk = base + len - off < n ? base + len - off : n;
+        if (!buf) memset(p, 0, (size_t)chunk);
+        else if (write) memcpy(p, buf, (size_t)chunk);
+        else memcpy(buf, p, (size_t)chunk);
+        if (buf) buf += chunk;
+        off += chunk;
+        n -= chunk;
+        base += len;
+    }
+}
+
+int ext_write(ExtFile *f, long long off, const void *src, long long n) {
+    if (off < 0 || n < 0 || off + n > EXT_MAX_SIZE) return -1;
+    if (reserve(f, off + n) == -1) return -1;
+    if (off > f->size) walk(f, f->size, off - f->size, NULL, 1);  // Hueco con ceros
+    walk(f, off, n, (unsigned char *)src, 1);
+    if (off + n > f->size) f->size = off + n;
+    return 0;
+}
+
+long long ext_read(const ExtFile *f, long long off, void *dst, long long n) {
+    if (off < 0 || n <= 0 || off >= f->size) return 0;
+    if (n > f->size - off) n = f->size - off;
+    walk(f, off, n, dst, 0);
+    return n;
+}
+
+int ext_truncate(ExtFile *f, long long size) {
+    if (size < 0 || size > EXT_MAX_SIZE) return -1;
+    if (size > f->size) {
+        if (reserve(f, size) == -1) return -1;
+        walk(f, f->size, size - f->size, NULL, 1);
+    } else {
+        trim_blocks(f, size);
+    }
+    f->size = size;
+    return 0;
+}
+
+void ext_free(ExtFile *f) {
+    trim_blocks(f, 0);
+    free(f->ext);
+    ext_init(f);
+}
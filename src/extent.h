@@ -0,0 +1,54 @@
+#ifndef EXTENT_H
+#define EXTENT_H
+
+// =====================================================
+// 📌 Almacén de bloques con extents (datos del VFS)
+// =====================================================
+// Los datos de los archivos viven en un almacén de bloques de
+// EXT_BLOCK bytes que crece y se encoge bajo demanda (bitmap de
+// bloques libres). Cada archivo guarda una lista de extents: tramos
+// de bloques contiguos. Al crecer, un archivo intenta extender su
+// último extent en el lugar; si no puede, agrega uno nuevo.
+
+// Tamaño de cada bloque del almacén
+#define EXT_BLOCK 512
+
+// Tamaño máximo de un archivo
+#define EXT_MAX_SIZE (256LL << 20)
+
+// Tramo de bloques contiguos
+typedef struct {
+    int start;       // Primer bloque
+    int count;       // Bloques del tramo
+} Extent;
+
+// Datos de un archivo
+typedef struct {
+    Extent *ext;     // Extents en orden de desplazamiento
+    int len, cap;    // Extents usados / reservados
+    int blocks;      // Bloques asignados (suma de los extents)
+    long long size;  // Bytes del archivo
+} ExtFile;
+
+// Deja un archivo vacío (no reserva nada)
+void ext_init(ExtFile *f);
+
+// Devuelve todos los bloques del archivo y lo deja vacío
+void ext_free(ExtFile *f);
+
+// Escribe 'n' bytes en 'off', asignando bloques si hace falta (un
+// hueco entre el final y 'off' se rellena con ceros).
+// Devuelve 0 o -1 sin espacio o por encima de EXT_MAX_SIZE
+int ext_write(ExtFile *f, long long off, const void *src, long long n);
+
+// Lee hasta 'n' bytes desde 'off'. Devuelve los bytes leídos
+long long ext_read(const ExtFile *f, long long off, void *dst, long long n);
+
+// Cambia el tamaño: al achicar devuelve los bloques sobrantes,
+// al agrandar rellena con ceros. Devuelve 0 o -1
+int ext_truncate(ExtFile *f, long long size);
+
+// Bloques en uso y bloques reservados por el almacén
+void ext_store_stats(long long *used, long long *total);
+
+#endif // EXTENT_H
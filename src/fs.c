@@ -1,144 +1,923 @@
 #include <stdio.h>     // Librería estándar de E/S (fopen, fread, fwrite, printf...)
 #include <string.h>    // Manejo de cadenas (strcmp, strncpy, strlen, memset...)
 #include <stdlib.h>    // Funciones estándar (malloc, free, atoi...)
+#include <stdint.h>    // Enteros de ancho fijo (formato de la imagen en disco)
+#ifndef _WIN32
+#include <sys/mman.h>  // Para mmap (imagen en disco)
+#include <sys/stat.h>  // Para fstat
+#include <fcntl.h>     // Para open
+#include <unistd.h>    // Para close
+#endif
 #include "fs.h"        // Header propio con definiciones de constantes y prototipos
+#include "extent.h"    // Almacén de bloques con extents (datos de los archivos)
+#include "rbtree.h"    // Entradas ordenadas por (directorio, nombre)
 #include "log.h"       // Módulo de logging
 
+#define FS_ROOT 0      // Inodo del directorio raíz
+
 // ===============================
 // Definición de estructuras
 // ===============================
 
-// Representa un archivo dentro del Sistema de Archivos Virtual (VFS)
+// Inodo del Sistema de Archivos Virtual (VFS): un archivo o un directorio
 typedef struct {
-    char name[MAX_NAME];      // Nombre del archivo
-    char content[MAX_CONTENT]; // Contenido almacenado en el archivo
+    char name[MAX_NAME];      // Componente del nombre (sin '/')
+    ExtFile data;             // Contenido: extents en el almacén de bloques
+    unsigned int hash;        // Hash de (padre, nombre), cacheado para el índice
+    int parent;               // Directorio que lo contiene (-1 = raíz)
+    int is_dir;               // 1 si es un directorio
+    int children;             // Entradas dentro (solo directorios)
+    int path_len;             // Largo de la ruta completa desde la raíz
+    int img;                  // Entrada de la imagen montada (-1 = solo en memoria)
+    int lazy;                 // 1 si el contenido sigue en la imagen (sin copiar)
+    int expanded;             // Directorio: todos sus hijos de la imagen ya cargados
     int used;                 // Indicador: 1 si está en uso, 0 si está vacío
+    int next_free;            // Siguiente entrada libre (si no está en uso)
 } FileEntry;
 
-// Arreglo estático de archivos (capacidad máxima definida en fs.h con MAX_FILES)
-static FileEntry files[MAX_FILES];
+// Tabla de inodos: crece duplicándose hasta FS_MAX_FILES
+static FileEntry *files = NULL;
+static int file_cap = 0;      // Entradas reservadas
+static int free_head = -1;    // Entradas libres, encadenadas por 'next_free'
+static int cwd = FS_ROOT;     // Directorio actual
+
+// Caché de dentries: índice hash (padre, nombre) → inodo, con
+// direccionamiento abierto, sondeo lineal y borrado por
+// desplazamiento hacia atrás (como intmap.c). Resuelve cada
+// componente de una ruta en O(1)
+static int *name_index = NULL; // Entrada de cada casilla (-1 = vacía)
+static int index_cap = 0;      // Casillas (potencia de 2)
+static int index_len = 0;      // Casillas ocupadas
+
+// Todas las entradas ordenadas por (padre, nombre): los hijos de un
+// directorio forman un tramo contiguo y ordenado del árbol
+static RbTree dir_tree;
+static int tree_ready = 0;
+
+// ===============================
+// Índice hash de nombres
+// ===============================
+
+// Hash FNV-1a del directorio padre y los 'len' bytes del nombre
+static unsigned int name_hash(int parent, const char *name, int len) {
+    unsigned int h = 2166136261U;
+    for (int k = 0; k < 4; ++k) {
+        h ^= ((unsigned int)parent >> (8 * k)) & 0xFF;
+        h *= 16777619U;
+    }
+    for (int k = 0; k < len; ++k) {
+        h ^= (unsigned char)name[k];
+        h *= 16777619U;
+    }
+    return h;
+}
+
+// Reconstruye el índice con 'ncap' casillas usando los hashes cacheados
+static int index_grow(int ncap) {
+    int *ni = malloc((size_t)ncap * sizeof(int));
+    if (!ni) return -1;
+    for (int i = 0; i < ncap; ++i) ni[i] = -1;
+    unsigned int mask = (unsigned int)(ncap - 1);
+    for (int i = 0; i < index_cap; ++i) {
+        if (name_index[i] < 0) continue;
+        unsigned int j = files[name_index[i]].hash & mask;
+        while (ni[j] >= 0) j = (j + 1) & mask;
+        ni[j] = name_index[i];
+    }
+    free(name_index);
+    name_index = ni;
+    index_cap = ncap;
+    return 0;
+}
+
+// Casilla del índice que apunta a la entrada 'idx'
+static unsigned int index_slot(int idx) {
+    unsigned int mask = (unsigned int)(index_cap - 1);
+    unsigned int i = files[idx].hash & mask;
+    while (name_index[i] != idx) i = (i + 1) & mask;
+    return i;
+}
+
+// Agrega la entrada 'idx' (con su hash ya calculado) al índice
+static int index_insert(int idx) {
+    // Mantener factor de carga <= 1/2
+    if ((index_len + 1) * 2 > index_cap && index_grow(index_cap ? index_cap * 2 : 2 * MAX_FILES) == -1)
+        return -1;
+    unsigned int mask = (unsigned int)(index_cap - 1);
+    unsigned int i = files[idx].hash & mask;
+    while (name_index[i] >= 0) i = (i + 1) & mask;
+    name_index[i] = idx;
+    index_len++;
+    return 0;
+}
+
+// Quita la entrada 'idx' del índice (sin lápidas)
+static void index_remove(int idx) {
+    unsigned int mask = (unsigned int)(index_cap - 1);
+    unsigned int i = index_slot(idx), j = i;
+    for (;;) {
+        name_index[i] = -1;
+        for (;;) {
+            j = (j + 1) & mask;
+            if (name_index[j] < 0) { index_len--; return; }
+            unsigned int home = files[name_index[j]].hash & mask;
+            // ¿La casilla j puede ocupar el hueco i sin romper su sondeo?
+            if (i <= j ? (home <= i || home > j) : (home <= i && home > j)) break;
+        }
+        name_index[i] = name_index[j];
+        i = j;
+    }
+}
+
+// Duplica la tabla de archivos y encadena las entradas nuevas como libres
+static int files_grow(void) {
+    if (file_cap >= FS_MAX_FILES) return -1;
+    int ncap = file_cap ? file_cap * 2 : MAX_FILES;
+    FileEntry *nf = realloc(files, (size_t)ncap * sizeof(FileEntry));
+    if (!nf) return -1;
+    files = nf;
+    for (int i = ncap - 1; i >= file_cap; --i) {
+        files[i].used = 0;
+        files[i].next_free = free_head;
+        free_head = i;
+    }
+    file_cap = ncap;
+    return 0;
+}
+
+// Busca el componente 'name' (de 'len' bytes) dentro del directorio
+// 'parent'. Solo compara nombres cuyo hash coincide. -1 si no existe
+static int dentry_lookup(int parent, const char *name, int len) {
+    if (index_cap == 0 || len >= MAX_NAME) return -1;
+    unsigned int h = name_hash(parent, name, len);
+    unsigned int mask = (unsigned int)(index_cap - 1);
+    for (unsigned int i = h & mask; name_index[i] >= 0; i = (i + 1) & mask) {
+        const FileEntry *e = &files[name_index[i]];
+        if (e->hash == h && e->parent == parent &&
+            strncmp(e->name, name, len) == 0 && e->name[len] == '\0')
+            return name_index[i];
+    }
+    return -1;
+}
+
+// ===============================
+// Orden por directorio
+// ===============================
+
+typedef struct {
+    int parent;
+    const char *name;
+} DirKey;
+
+static int dir_less(int a, int b, void *ctx) {
+    (void)ctx;
+    if (files[a].parent != files[b].parent) return files[a].parent < files[b].parent;
+    return strcmp(files[a].name, files[b].name) < 0;
+}
+
+static int dir_below(int id, const void *key) {
+    const DirKey *k = key;
+    if (files[id].parent != k->parent) return files[id].parent < k->parent;
+    return strcmp(files[id].name, k->name) < 0;
+}
+
+// Primer hijo (en orden de nombre) del directorio 'dir' o -1: O(log N)
+static int first_child(int dir) {
+    DirKey k = { dir, "" };
+    int id = rb_lower_bound(&dir_tree, dir_below, &k);
+    return (id != -1 && files[id].parent == dir) ? id : -1;
+}
+
+// Siguiente hermano en orden de nombre o -1
+static int next_child(int id) {
+    int n = rb_next(&dir_tree, id);
+    return (n != -1 && files[n].parent == files[id].parent) ? n : -1;
+}
+
+// ===============================
+// Inodos
+// ===============================
+
+// Toma una entrada libre para el nombre 'name' (de 'len' bytes) dentro
+// de 'parent' y la agrega a la caché de dentries y al árbol
+// Retorna su índice o -1 si la ruta es muy larga o no hay espacio
+static int entry_alloc(int parent, const char *name, int len, int is_dir) {
+    int path_len = files[parent].path_len + 1 + len;
+    if (len == 0 || len >= MAX_NAME || path_len >= FS_MAX_PATH) return -1;
+    if (free_head == -1 && files_grow() == -1)
+        return -1; // No hay espacio disponible
+    int i = free_head; // Primera posición libre
+    memcpy(files[i].name, name, (size_t)len);
+    files[i].name[len] = '\0';
+    files[i].hash = name_hash(parent, name, len);
+    files[i].parent = parent;
+    if (index_insert(i) == -1) return -1;
+    if (rb_insert(&dir_tree, i) == -1) { index_remove(i); return -1; }
+    free_head = files[i].next_free;
+    files[i].used = 1;
+    files[i].is_dir = is_dir;
+    files[i].children = 0;
+    files[i].path_len = path_len;
+    files[i].img = -1;
+    files[i].lazy = 0;
+    files[i].expanded = 0;
+    ext_init(&files[i].data); // Contenido vacío (sin bloques)
+    return i;
+}
+
+// ===============================
+// Imagen en disco (formato v2)
+// ===============================
+// [FsImgHeader][FsImgEntry x count][int32 x slots][nombres][datos]
+//
+// La entrada 0 es la raíz y los hijos de cada directorio son entradas
+// contiguas ordenadas por nombre. El índice hash (padre, nombre) de
+// la imagen se consulta directo sobre el mapeo: montarla es O(1) y
+// cada inodo se materializa en memoria la primera vez que una ruta
+// lo alcanza. El contenido de un archivo se lee del mapeo (el sistema
+// trae las páginas al primer acceso) y se copia al almacén de bloques
+// recién cuando se modifica
+
+#define IMG_MAGIC "CSVFSIMG"
+#define IMG_VERSION 2
+
+typedef struct {
+    char magic[8];         // IMG_MAGIC (sin terminador)
+    uint32_t version;      // IMG_VERSION
+    uint32_t count;        // Entradas (la 0 es la raíz)
+    uint32_t slots;        // Casillas del índice hash (potencia de 2)
+    uint32_t reserved;
+    uint64_t entries_off;  // Directorio de entradas
+    uint64_t index_off;    // Índice hash: entrada por casilla (-1 = vacía)
+    uint64_t names_off;    // Nombres (sin terminador)
+    uint64_t data_off;     // Contenido de los archivos
+} FsImgHeader;
+
+typedef struct {
+    int32_t parent;        // Entrada del directorio padre (-1 = raíz)
+    int32_t is_dir;        // 1 si es un directorio
+    int32_t first;         // Directorio: primer hijo
+    int32_t nchildren;     // Directorio: cantidad de hijos
+    uint32_t hash;         // name_hash(parent, nombre)
+    uint32_t name_len;     // Bytes del nombre
+    uint64_t name_off;     // Nombre, desde names_off
+    uint64_t data_off;     // Contenido, desde data_off
+    int64_t size;          // Bytes del archivo
+} FsImgEntry;
+
+static const unsigned char *img_base = NULL; // Imagen montada (NULL = ninguna)
+static size_t img_size = 0;
+static const FsImgHeader *img_hdr = NULL;
+static unsigned char *img_gone = NULL;       // Entradas eliminadas (bitmap)
+static int img_loaded = 0;                   // Inodos materializados
+
+// ¿[off, off + len) cae dentro de la imagen?
+static int img_range(uint64_t off, uint64_t len) {
+    return off <= img_size && len <= img_size - off;
+}
+
+// Entrada 'e' de la imagen o NULL si no existe o está dañada. Se
+// valida al usarla (no al montar) para que montar siga siendo O(1)
+static const FsImgEntry *img_entry(int e) {
+    if (!img_base || e < 0 || (uint32_t)e >= img_hdr->count) return NULL;
+    const FsImgEntry *en = (const FsImgEntry *)(img_base + img_hdr->entries_off) + e;
+    if (en->name_len >= MAX_NAME || !img_range(img_hdr->names_off + en->name_off, en->name_len))
+        return NULL;
+    if (en->is_dir) {
+        if (en->first < 0 || en->nchildren < 0 ||
+            (int64_t)en->first + en->nchildren > (int64_t)img_hdr->count) return NULL;
+    } else if (en->size < 0 || en->size > EXT_MAX_SIZE ||
+               !img_range(img_hdr->data_off + en->data_off, (uint64_t)en->size)) {
+        return NULL;
+    }
+    return en;
+}
+
+static const char *img_name(const FsImgEntry *en) {
+    return (const char *)img_base + img_hdr->names_off + en->name_off;
+}
+
+static int img_is_gone(int e) {
+    return img_gone && ((img_gone[e >> 3] >> (e & 7)) & 1);
+}
+
+// Marca una entrada de la imagen como eliminada para no volver a materializarla
+static void img_mark_gone(int e) {
+    if (!img_gone) img_gone = calloc((img_hdr->count + 7) / 8, 1);
+    if (img_gone) img_gone[e >> 3] |= (unsigned char)(1 << (e & 7));
+}
+
+// Busca (padre, nombre) en el índice hash mapeado. -1 si no está
+static int img_lookup(int pimg, const char *name, int len) {
+    uint32_t h = name_hash(pimg, name, len);
+    uint32_t mask = img_hdr->slots - 1;
+    const int32_t *slot = (const int32_t *)(img_base + img_hdr->index_off);
+    for (uint32_t i = h & mask, n = 0; n < img_hdr->slots && slot[i] >= 0; i = (i + 1) & mask, ++n) {
+        const FsImgEntry *en = img_entry(slot[i]);
+        if (en && en->hash == h && en->parent == pimg && en->name_len == (uint32_t)len &&
+            memcmp(img_name(en), name, (size_t)len) == 0)
+            return slot[i];
+    }
+    return -1;
+}
+
+// Crea en memoria el inodo de la entrada 'e' dentro de 'parent'
+// (el padre ya la cuenta entre sus hijos)
+static int img_materialize(int parent, int e) {
+    const FsImgEntry *en = img_entry(e);
+    if (!en) return -1;
+    int i = entry_alloc(parent, img_name(en), (int)en->name_len, en->is_dir != 0);
+    if (i == -1) return -1;
+    files[i].img = e;
+    files[i].lazy = !en->is_dir;
+    files[i].children = en->is_dir ? en->nchildren : 0;
+    img_loaded++;
+    return i;
+}
+
+// Carga todos los hijos de un directorio de la imagen (para listarlo):
+// O(hijos). Luego el árbol en memoria es completo
+static void dir_expand(int dir) {
+    if (files[dir].img < 0 || files[dir].expanded) return;
+    const FsImgEntry *d = img_entry(files[dir].img);
+    for (int e = d ? d->first : 0; d && e < d->first + d->nchildren; ++e) {
+        const FsImgEntry *en = img_entry(e);
+        if (!en || img_is_gone(e) || dentry_lookup(dir, img_name(en), (int)en->name_len) != -1) continue;
+        img_materialize(dir, e);
+    }
+    files[dir].expanded = 1;
+}
+
+// Busca un componente: primero en la caché de dentries y, si falta y
+// el directorio viene de la imagen, en el índice mapeado
+static int lookup(int parent, const char *name, int len) {
+    int id = dentry_lookup(parent, name, len);
+    if (id != -1 || files[parent].img < 0 || files[parent].expanded) return id;
+    int e = img_lookup(files[parent].img, name, len);
+    if (e == -1 || img_is_gone(e)) return -1;
+    return img_materialize(parent, e);
+}
+
+// Tamaño de un archivo (sin traer su contenido)
+static long long file_size(int idx) {
+    if (!files[idx].lazy) return files[idx].data.size;
+    return img_entry(files[idx].img)->size;
+}
+
+// Lee del almacén o, si el archivo no se modificó, directo del mapeo
+static long long file_read(int idx, long long off, void *buf, long long n) {
+    if (!files[idx].lazy) return ext_read(&files[idx].data, off, buf, n);
+    const FsImgEntry *en = img_entry(files[idx].img);
+    if (off < 0 || n <= 0 || off >= en->size) return 0;
+    if (n > en->size - off) n = en->size - off;
+    memcpy(buf, img_base + img_hdr->data_off + en->data_off + off, (size_t)n);
+    return n;
+}
+
+// Antes de modificar un archivo de la imagen copia su contenido al
+// almacén de bloques. Retorna 0 o -1 sin espacio
+static int file_fault_in(int idx) {
+    if (!files[idx].lazy) return 0;
+    const FsImgEntry *en = img_entry(files[idx].img);
+    if (ext_write(&files[idx].data, 0, img_base + img_hdr->data_off + en->data_off, en->size) == -1)
+        return -1;
+    files[idx].lazy = 0;
+    return 0;
+}
+
+// Desmonta la imagen (los inodos que venían de ella ya se liberaron)
+static void img_unmount(void) {
+    if (img_base) {
+#ifdef _WIN32
+        free((void *)img_base);
+#else
+        munmap((void *)img_base, img_size);
+#endif
+    }
+    img_base = NULL;
+    img_hdr = NULL;
+    img_size = 0;
+    free(img_gone);
+    img_gone = NULL;
+    img_loaded = 0;
+}
+
+// Mapea la imagen de 'path' y la cuelga de la raíz sin leer sus
+// entradas: solo valida la cabecera. Retorna 0 o -1 si no es válida
+static int img_mount(const char *path) {
+#ifdef _WIN32
+    // Sin mmap: la imagen se lee completa a memoria
+    FILE *f = fopen(path, "rb");
+    if (!f) return -1;
+    fseek(f, 0, SEEK_END);
+    long size = ftell(f);
+    rewind(f);
+    unsigned char *buf = size > 0 ? malloc((size_t)size) : NULL;
+    if (!buf || fread(buf, 1, (size_t)size, f) != (size_t)size) { free(buf); fclose(f); return -1; }
+    fclose(f);
+    img_base = buf;
+    img_size = (size_t)size;
+#else
+    int fd = open(path, O_RDONLY);
+    if (fd == -1) return -1;
+    struct stat st;
+    if (fstat(fd, &st) == -1 || st.st_size <= 0) { close(fd); return -1; }
+    void *p = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);   // El mapeo sigue vigente
+    if (p == MAP_FAILED) return -1;
+    img_base = p;
+    img_size = (size_t)st.st_size;
+#endif
+    img_hdr = (const FsImgHeader *)img_base;
+    const FsImgEntry *root = NULL;
+    if (img_size >= sizeof(FsImgHeader) && memcmp(img_hdr->magic, IMG_MAGIC, 8) == 0 &&
+        img_hdr->version == IMG_VERSION && img_hdr->count > 0 &&
+        img_hdr->slots > 0 && (img_hdr->slots & (img_hdr->slots - 1)) == 0 &&
+        img_range(img_hdr->entries_off, (uint64_t)img_hdr->count * sizeof(FsImgEntry)) &&
+        img_range(img_hdr->index_off, (uint64_t)img_hdr->slots * sizeof(int32_t)) &&
+        img_hdr->names_off <= img_size && img_hdr->data_off <= img_size)
+        root = img_entry(0);
+    if (!root || !root->is_dir) { img_unmount(); return -1; }
+
+    files[FS_ROOT].img = 0;
+    files[FS_ROOT].children = root->nchildren;
+    return 0;
+}
+
+// ===============================
+// Rutas
+// ===============================
+
+// Resuelve 'path' (absoluta o relativa al directorio actual, con
+// '.' y '..') componente por componente en la caché de dentries.
+// Con 'leaf' != NULL se detiene antes del último componente: devuelve
+// el directorio que lo contendría y copia su nombre en 'leaf'.
+// Retorna el inodo o -1 si algún componente no existe
+static int resolve(const char *path, char *leaf) {
+    int cur = (path[0] == '/') ? FS_ROOT : cwd;
+    const char *p = path;
+    for (;;) {
+        while (*p == '/') p++;
+        if (!*p) break;
+        const char *end = p;
+        while (*end && *end != '/') end++;
+        int len = (int)(end - p);
+        const char *rest = end;
+        while (*rest == '/') rest++;
+        int dot = (len == 1 && p[0] == '.');
+        int dotdot = (len == 2 && p[0] == '.' && p[1] == '.');
+
+        if (!files[cur].is_dir) return -1;  // Un archivo no tiene componentes
+        if (leaf && !*rest) {
+            // Último componente: el nombre a crear / eliminar
+            if (dot || dotdot || len >= MAX_NAME) return -1;
+            memcpy(leaf, p, (size_t)len);
+            leaf[len] = '\0';
+            return cur;
+        }
+        if (dotdot) {
+            if (files[cur].parent >= 0) cur = files[cur].parent;
+        } else if (!dot) {
+            cur = lookup(cur, p, len);
+            if (cur == -1) return -1;
+        }
+        p = end;
+    }
+    return leaf ? -1 : cur;  // Sin último componente (p.ej. "/")
+}
+
+// Inodo de un archivo regular en 'path' o -1 (no existe o es directorio)
+static int file_of(const char *path) {
+    int idx = resolve(path, NULL);
+    return (idx != -1 && !files[idx].is_dir) ? idx : -1;
+}
+
+// Escribe en 'buf' la ruta absoluta del inodo 'idx'. Retorna 0 o -1
+static int entry_path(int idx, char *buf, int maxlen) {
+    int len = files[idx].path_len > 0 ? files[idx].path_len : 1;
+    if (len >= maxlen) return -1;
+    buf[len] = '\0';
+    if (idx == FS_ROOT) { buf[0] = '/'; return 0; }
+    for (int i = idx; i != FS_ROOT; i = files[i].parent) {
+        int n = (int)strlen(files[i].name);
+        len -= n;
+        memcpy(buf + len, files[i].name, (size_t)n);
+        buf[--len] = '/';
+    }
+    return 0;
+}
+
+// Crea el inodo 'name' dentro del directorio 'parent'
+// Retorna su índice o -1 si ya existe, la ruta es muy larga o no hay espacio
+static int entry_new(int parent, const char *name, int is_dir) {
+    int len = (int)strlen(name);
+    if (parent == -1 || !files[parent].is_dir) return -1;
+    if (lookup(parent, name, len) != -1) return -1; // Ya existe
+    int i = entry_alloc(parent, name, len, is_dir);
+    if (i != -1) files[parent].children++;
+    return i;
+}
+
+// Quita un inodo de la caché y del árbol y devuelve su entrada a la lista de libres
+static void entry_drop(int idx) {
+    index_remove(idx);
+    rb_erase(&dir_tree, idx);
+    files[files[idx].parent].children--;
+    if (files[idx].img >= 0) img_mark_gone(files[idx].img); // Que no reaparezca
+    files[idx].used = 0;
+    files[idx].name[0] = '\0';
+    ext_free(&files[idx].data); // Sus bloques vuelven al almacén
+    files[idx].next_free = free_head;
+    free_head = idx;
+}
 
 // ===============================
 // Funciones principales del VFS
 // ===============================
 
-// Inicializa el sistema de archivos virtual, marcando todas las entradas como libres
+// Inicializa el sistema de archivos virtual: libera todas las entradas
+// y deja solo el directorio raíz, que pasa a ser el actual
 int fs_init() {
-    for (int i = 0; i < MAX_FILES; ++i) 
+    if (!files && files_grow() == -1) return -1;
+    if (!tree_ready) { rb_init(&dir_tree, dir_less, NULL); tree_ready = 1; }
+    rb_clear(&dir_tree);
+    free_head = -1;
+    for (int i = file_cap - 1; i >= 0; --i) {
+        if (files[i].used) ext_free(&files[i].data); // Devuelve sus bloques
         files[i].used = 0; // Marca todas las posiciones como "no usadas"
+        files[i].next_free = free_head;
+        free_head = i;
+    }
+    for (int i = 0; i < index_cap; ++i) name_index[i] = -1;
+    index_len = 0;
+    img_unmount();
+
+    // La raíz ocupa la entrada 0 y no está en el índice ni en el árbol
+    free_head = files[FS_ROOT].next_free;
+    files[FS_ROOT].used = 1;
+    files[FS_ROOT].name[0] = '\0';
+    files[FS_ROOT].parent = -1;
+    files[FS_ROOT].is_dir = 1;
+    files[FS_ROOT].children = 0;
+    files[FS_ROOT].path_len = 0;
+    files[FS_ROOT].img = -1;
+    files[FS_ROOT].lazy = 0;
+    files[FS_ROOT].expanded = 0;
+    ext_init(&files[FS_ROOT].data);
+    cwd = FS_ROOT;
     return 0;
 }
 
-// Busca un archivo por nombre y devuelve su índice en el arreglo
-// Retorna -1 si no existe
+// Busca un archivo por ruta y devuelve su índice en el arreglo
+// Retorna -1 si no existe o si es un directorio
 int fs_find(const char *name) {
-    for (int i = 0; i < MAX_FILES; ++i) {
-        // Verifica si la entrada está en uso y compara el nombre
-        if (files[i].used && strcmp(files[i].name, name) == 0) 
-            return i;
-    }
-    return -1; // No encontrado
+    return file_of(name);
 }
 
-// Elimina un archivo por nombre del VFS
+// Elimina un archivo por ruta del VFS
 // Retorna 0 si se eliminó, -1 si no existe
 int fs_rmfile(const char *name) {
-    int idx = fs_find(name);
+    int idx = file_of(name);
     if (idx == -1) return -1; // No existe archivo con ese nombre
-
-    // Resetea la entrada
-    files[idx].used = 0;
-    files[idx].name[0] = '\0';
-    files[idx].content[0] = '\0';
+    entry_drop(idx);
     return 0; // Eliminado con éxito
 }
 
-// Crea un archivo vacío en el VFS
+// Crea un archivo vacío en el VFS (su directorio debe existir)
 // Retorna el índice de la entrada creada o -1 si ya existe o no hay espacio
 int fs_mkfile(const char *name) {
-    if (fs_find(name) != -1) {
-        return -1; // Ya existe un archivo con ese nombre
-    }
-    for (int i = 0; i < MAX_FILES; ++i) {
-        if (!files[i].used) { // Encuentra una posición libre
-            files[i].used = 1;
-            strncpy(files[i].name, name, MAX_NAME-1); // Copia el nombre
-            files[i].content[0] = '\0'; // Contenido vacío
-            return i;
-        }
-    }
-    return -1; // No hay espacio disponible
+    char leaf[MAX_NAME];
+    int parent = resolve(name, leaf);
+    return entry_new(parent, leaf, 0);
 }
 
-// Escribe contenido en un archivo existente
-// Retorna 0 si éxito, -1 si el archivo no existe
+// Crea un directorio vacío
+// Retorna su índice o -1 si ya existe, falta el padre o no hay espacio
+int fs_mkdir(const char *path) {
+    char leaf[MAX_NAME];
+    int parent = resolve(path, leaf);
+    return entry_new(parent, leaf, 1);
+}
+
+// Elimina un directorio vacío (ni la raíz ni el actual)
+// Retorna 0 si se eliminó, -1 si no
+int fs_rmdir(const char *path) {
+    int idx = resolve(path, NULL);
+    if (idx == -1 || !files[idx].is_dir || idx == FS_ROOT) return -1;
+    if (files[idx].children > 0 || idx == cwd) return -1;
+    entry_drop(idx);
+    return 0;
+}
+
+// Cambia el directorio actual. Retorna 0 o -1 si no es un directorio
+int fs_chdir(const char *path) {
+    int idx = resolve(path, NULL);
+    if (idx == -1 || !files[idx].is_dir) return -1;
+    cwd = idx;
+    return 0;
+}
+
+// Ruta absoluta del directorio actual. Retorna 0 o -1 si no entra
+int fs_getcwd(char *buf, int maxlen) {
+    return entry_path(cwd, buf, maxlen);
+}
+
+// Reemplaza el contenido de un archivo existente: los bloques
+// sobrantes vuelven al almacén y solo se usan los necesarios
+// Retorna 0 si éxito, -1 si el archivo no existe o no hay espacio
 int fs_write(const char *name, const char *content) {
     int idx = fs_find(name);
     if (idx == -1) return -1; // Archivo no encontrado
-    strncpy(files[idx].content, content, MAX_CONTENT - 1);
-    files[idx].content[MAX_CONTENT - 1] = '\0';  // Asegurar terminador
-    return 0;
+    files[idx].lazy = 0;      // El contenido de la imagen se descarta
+    long long len = (long long)strlen(content);
+    if (ext_write(&files[idx].data, 0, content, len) == -1) return -1;
+    return ext_truncate(&files[idx].data, len);
 }
 
 // Lee el contenido de un archivo y lo copia en un buffer
+// (a lo sumo maxlen-1 bytes, siempre con terminador)
 // Retorna 0 si éxito, -1 si el archivo no existe
 int fs_read(const char *name, char *outbuf, int maxlen) {
     int idx = fs_find(name);
     if (idx == -1) return -1; // No existe
-    strncpy(outbuf, files[idx].content, maxlen-1);
+    long long n = file_read(idx, 0, outbuf, maxlen - 1);
+    outbuf[n] = '\0';
+    return 0;
+}
+
+// Tamaño del archivo en bytes o -1 si no existe
+long long fs_size(const char *name) {
+    int idx = fs_find(name);
+    return idx == -1 ? -1 : file_size(idx);
+}
+
+// Lee desde un desplazamiento: solo copia los bytes pedidos
+// Retorna los bytes leídos o -1 si el archivo no existe
+long long fs_pread(const char *name, void *buf, long long n, long long off) {
+    int idx = fs_find(name);
+    if (idx == -1 || off < 0) return -1;
+    return file_read(idx, off, buf, n);
+}
+
+// Escribe en un desplazamiento sin reescribir el resto del archivo
+// Retorna los bytes escritos o -1 si no existe o no hay espacio
+long long fs_pwrite(const char *name, const void *buf, long long n, long long off) {
+    int idx = fs_find(name);
+    if (idx == -1 || file_fault_in(idx) == -1) return -1;
+    return ext_write(&files[idx].data, off, buf, n) == 0 ? n : -1;
+}
+
+// Agrega al final: el costo depende solo de los bytes agregados
+long long fs_append(const char *name, const void *buf, long long n) {
+    int idx = fs_find(name);
+    if (idx == -1 || file_fault_in(idx) == -1) return -1;
+    return ext_write(&files[idx].data, files[idx].data.size, buf, n) == 0 ? n : -1;
+}
+
+// Cambia el tamaño (los bloques sobrantes vuelven al almacén)
+int fs_truncate(const char *name, long long size) {
+    int idx = fs_find(name);
+    if (idx == -1 || file_fault_in(idx) == -1) return -1;
+    return ext_truncate(&files[idx].data, size);
+}
+
+// Lista el contenido de un directorio (NULL = el actual) en orden de
+// nombre: recorre solo el tramo de sus hijos en el árbol
+// Retorna 0 o -1 si la ruta no existe
+int fs_ls(const char *path) {
+    int dir = path ? resolve(path, NULL) : cwd;
+    if (dir == -1) return -1;
+    char where[FS_MAX_PATH];
+    entry_path(dir, where, sizeof(where));
+    if (!files[dir].is_dir) {
+        Mostrar(" - %s (len=%lld)\n", where, file_size(dir));
+        return 0;
+    }
+    dir_expand(dir);   // Hijos que siguen solo en la imagen
+    Mostrar("Archivos en VFS (Sistema de Archivos Virtual) - %s:\n", where);
+    for (int i = first_child(dir); i != -1; i = next_child(i)) {
+        if (files[i].is_dir) Mostrar(" - %s/ (dir, %d entrada(s))\n", files[i].name, files[i].children);
+        else Mostrar(" - %s (len=%lld)\n", files[i].name, file_size(i));
+    }
+    long long used, total;
+    ext_store_stats(&used, &total);
+    Mostrar("Almacen: %lld de %lld bloque(s) de %d bytes en uso\n", used, total, EXT_BLOCK);
+    if (img_base)
+        Mostrar("Imagen montada: %u entrada(s), %d cargada(s) en memoria\n", img_hdr->count - 1, img_loaded);
+    return 0;
+}
+
+// Entradas que fs_save va a escribir, en anchura desde la raíz
+typedef struct {
+    int *order;           // Inodo de cada entrada o IMG_REF(e) si nunca se cargó
+    FsImgEntry *ents;     // Registro de cada entrada en la imagen nueva
+    int len, cap;
+    uint64_t names_len;
+} SaveList;
+
+// Entrada 'e' de la imagen montada que se copia sin materializarla
+#define IMG_REF(e) (-2 - (e))
+
+// Nombre (sin terminador) de una entrada de SaveList y su largo en 'n'
+static const char *save_name(int ref, int *n) {
+    if (ref >= 0) { *n = (int)strlen(files[ref].name); return files[ref].name; }
+    const FsImgEntry *en = img_entry(-2 - ref);
+    *n = (int)en->name_len;
+    return img_name(en);
+}
+
+// Agrega 'ref' como hijo de la entrada 'k'. Retorna 0 o -1 sin memoria
+static int save_add(SaveList *sl, int k, int ref) {
+    if (sl->len == sl->cap) {
+        sl->cap *= 2;
+        int *no = realloc(sl->order, (size_t)sl->cap * sizeof(int));
+        if (no) sl->order = no;
+        FsImgEntry *ne = realloc(sl->ents, (size_t)sl->cap * sizeof(FsImgEntry));
+        if (ne) sl->ents = ne;
+        if (!no || !ne) return -1;
+    }
+    int n;
+    const char *name = save_name(ref, &n);
+    FsImgEntry *en = &sl->ents[sl->len];
+    memset(en, 0, sizeof(FsImgEntry));
+    en->parent = k;
+    en->hash = name_hash(k, name, n);
+    en->name_len = (uint32_t)n;
+    en->name_off = sl->names_len;
+    sl->names_len += (uint64_t)n;
+    sl->order[sl->len++] = ref;
     return 0;
 }
 
-// Lista todos los archivos almacenados en el VFS
-void fs_ls() {
-    Mostrar("Archivos en VFS (Sistema de Archivos Virtual):\n");
-    for (int i = 0; i < MAX_FILES; ++i) {
-        if (files[i].used) {
-            Mostrar(" - %s (len=%zu)\n", files[i].name, strlen(files[i].content));
+// Hijos de un directorio de la imagen que no se expandió: las entradas
+// de la imagen se copian tal cual (sin cargarlas) y se intercalan por
+// nombre con las que ya están en memoria (cargadas, modificadas o nuevas)
+static int save_merge(SaveList *sl, int k, int dir) {
+    const FsImgEntry *d = img_entry(files[dir].img);
+    int e = d ? d->first : 0, end = d ? d->first + d->nchildren : 0;
+    int c = first_child(dir);
+    const FsImgEntry *en = NULL;
+    char ename[MAX_NAME];
+    for (;;) {
+        // Siguiente entrada de la imagen que solo existe allí
+        for (; !en && e < end; ) {
+            const FsImgEntry *x = img_entry(e);
+            if (x && !img_is_gone(e) && dentry_lookup(dir, img_name(x), (int)x->name_len) == -1) {
+                en = x;
+                memcpy(ename, img_name(x), x->name_len);
+                ename[x->name_len] = '\0';
+            } else {
+                e++;
+            }
+        }
+        if (!en && c == -1) return 0;
+        if (c != -1 && (!en || strcmp(files[c].name, ename) < 0)) {
+            if (save_add(sl, k, c) == -1) return -1;
+            c = next_child(c);
+        } else {
+            if (save_add(sl, k, IMG_REF(e)) == -1) return -1;
+            e++;
+            en = NULL;
         }
     }
 }
 
-// Guarda el estado del VFS en un archivo binario en disco
+// Guarda el estado del VFS como imagen v2 (ver "Imagen en disco")
 // Retorna 0 si éxito, -1 si error al abrir/escribir
-// Serializa el VFS completo a un archivo binario en disco para persistencia
+// Se escribe en '<path>.tmp' y luego se renombra: así la imagen
+// montada (que puede ser el mismo archivo) sigue intacta mientras
+// se copian los archivos que aún no se cargaron. Los directorios de
+// la imagen que nunca se listaron no se expanden: sus entradas pasan
+// de la imagen vieja a la nueva sin crear inodos en memoria
 int fs_save(const char *path) {
-    FILE *f = fopen(path, "wb");  // Modo binario para preservar estructura
-    if (!f) return -1;
+    // Entradas en anchura: los hijos de cada directorio quedan
+    // contiguos y ordenados por nombre
+    SaveList sl = { NULL, NULL, 1, MAX_FILES, 0 };
+    sl.order = malloc((size_t)sl.cap * sizeof(int));
+    sl.ents = malloc((size_t)sl.cap * sizeof(FsImgEntry));
+    if (!sl.order || !sl.ents) { free(sl.order); free(sl.ents); return -1; }
+    sl.order[0] = FS_ROOT;
+    memset(&sl.ents[0], 0, sizeof(FsImgEntry));
+    sl.ents[0].parent = -1;
+    uint64_t data_len = 0;
+    for (int k = 0; k < sl.len; ++k) {
+        int id = sl.order[k], rc = 0;
+        const FsImgEntry *en = id >= 0 ? NULL : img_entry(-2 - id);
+        if (en ? !en->is_dir : !files[id].is_dir) {
+            sl.ents[k].data_off = data_len;
+            sl.ents[k].size = en ? en->size : file_size(id);
+            data_len += (uint64_t)sl.ents[k].size;
+            continue;
+        }
+        sl.ents[k].is_dir = 1;
+        sl.ents[k].first = sl.len;
+        if (en) {
+            // Directorio que nunca se cargó: sus hijos solo están en la imagen
+            for (int e = en->first; rc == 0 && e < en->first + en->nchildren; ++e)
+                if (img_entry(e) && !img_is_gone(e)) rc = save_add(&sl, k, IMG_REF(e));
+        } else if (files[id].img >= 0 && !files[id].expanded) {
+            rc = save_merge(&sl, k, id);
+        } else {
+            for (int c = first_child(id); rc == 0 && c != -1; c = next_child(c))
+                rc = save_add(&sl, k, c);
+        }
+        if (rc == -1) { free(sl.order); free(sl.ents); return -1; }
+        sl.ents[k].nchildren = sl.len - sl.ents[k].first;
+    }
+    int len = sl.len, *order = sl.order;
+    FsImgEntry *ents = sl.ents;
+    uint64_t names_len = sl.names_len;
 
-    // Cuenta cuántos archivos están en uso
-    int count = 0;
-    for (int i = 0; i < MAX_FILES; ++i) 
-        if (files[i].used) count++;
+    // Índice hash (padre, nombre) con factor de carga <= 1/2
+    uint32_t slots = 2;
+    while (slots < 2 * (uint32_t)len) slots *= 2;
+    int32_t *index = malloc((size_t)slots * sizeof(int32_t));
+    if (!index) { free(order); free(ents); return -1; }
+    for (uint32_t i = 0; i < slots; ++i) index[i] = -1;
+    for (int k = 1; k < len; ++k) {
+        uint32_t i = ents[k].hash & (slots - 1);
+        while (index[i] >= 0) i = (i + 1) & (slots - 1);
+        index[i] = k;
+    }
 
-    // Escribe cantidad de archivos en disco
-    fwrite(&count, sizeof(int), 1, f);
+    FsImgHeader hdr;
+    memset(&hdr, 0, sizeof(hdr));
+    memcpy(hdr.magic, IMG_MAGIC, 8);
+    hdr.version = IMG_VERSION;
+    hdr.count = (uint32_t)len;
+    hdr.slots = slots;
+    hdr.entries_off = sizeof(FsImgHeader);
+    hdr.index_off = hdr.entries_off + (uint64_t)len * sizeof(FsImgEntry);
+    hdr.names_off = hdr.index_off + (uint64_t)slots * sizeof(int32_t);
+    hdr.data_off = hdr.names_off + names_len;
 
-    // Escribe cada archivo (nombre + contenido)
-    for (int i = 0; i < MAX_FILES; ++i) {
-        if (!files[i].used) continue;
-        int name_len = (int)strlen(files[i].name);
-        int content_len = (int)strlen(files[i].content);
-        fwrite(&name_len, sizeof(int), 1, f);
-        fwrite(files[i].name, 1, name_len, f);
-        fwrite(&content_len, sizeof(int), 1, f);
-        fwrite(files[i].content, 1, content_len, f);
+    char tmp[FS_MAX_PATH + 8];
+    snprintf(tmp, sizeof(tmp), "%s.tmp", path);
+    FILE *f = fopen(tmp, "wb");  // Modo binario para preservar estructura
+    if (f) {
+        fwrite(&hdr, sizeof(hdr), 1, f);
+        fwrite(ents, sizeof(FsImgEntry), (size_t)len, f);
+        fwrite(index, sizeof(int32_t), slots, f);
+        for (int k = 1; k < len; ++k) {
+            int n;
+            fwrite(save_name(order[k], &n), 1, ents[k].name_len, f);
+        }
+        // El contenido sale en trozos (del almacén o de la imagen montada)
+        for (int k = 1; k < len; ++k) {
+            if (ents[k].is_dir) continue;
+            if (order[k] < 0) {  // Nunca se cargó: directo del mapeo
+                const FsImgEntry *en = img_entry(-2 - order[k]);
+                fwrite(img_base + img_hdr->data_off + en->data_off, 1, (size_t)ents[k].size, f);
+                continue;
+            }
+            char chunk[4096];
+            long long off = 0, got;
+            while ((got = file_read(order[k], off, chunk, sizeof(chunk))) > 0) {
+                fwrite(chunk, 1, (size_t)got, f);
+                off += got;
+            }
+        }
     }
+    free(order);
+    free(ents);
+    free(index);
+    if (!f) return -1;
+    int err = ferror(f);
+    if (fclose(f) != 0 || err) { remove(tmp); return -1; }
+#ifdef _WIN32
+    remove(path);   // rename no reemplaza en Windows
+#endif
+    return rename(tmp, path) == 0 ? 0 : -1;
+}
 
-    fclose(f);
-    return 0;
+// Crea los directorios intermedios de 'path' que falten (como mkdir -p)
+static void make_parents(char *path) {
+    for (char *s = strchr(path + 1, '/'); s; s = strchr(s + 1, '/')) {
+        *s = '\0';
+        fs_mkdir(path);   // Si ya existe no hace nada
+        *s = '/';
+    }
 }
 
 // Carga el estado del VFS desde un archivo en disco
 // Retorna 0 si éxito, -1 si error
-// Deserializa el VFS desde un archivo binario, restaurando estado anterior
+// Una imagen v2 se monta sin leerla (O(1)); un archivo del formato
+// anterior (cantidad + registros ruta/contenido) se lee completo
 int fs_load(const char *path) {
     FILE *f = fopen(path, "rb");  // Modo binario para leer estructura
     if (!f) return -1;
 
-    // Limpia las entradas actuales
-    for (int i = 0; i < MAX_FILES; ++i) 
-        files[i].used = 0;
+    char magic[8];
+    if (fread(magic, 1, 8, f) == 8 && memcmp(magic, IMG_MAGIC, 8) == 0) {
+        fclose(f);
+        fs_init();
+        return img_mount(path);
+    }
+    rewind(f);
+
+    // Limpia las entradas actuales (y el índice); las rutas se
+    // resuelven desde la raíz
+    fs_init();
 
     int count = 0;
     // Si no se puede leer la cantidad, se aborta
@@ -147,25 +926,34 @@ int fs_load(const char *path) {
         return -1; 
     }
 
-    // Restaura cada archivo leído
+    // Restaura cada entrada leída
     for (int i = 0; i < count; ++i) {
         int name_len = 0;
         fread(&name_len, sizeof(int), 1, f);
+        if (name_len <= 0 || name_len >= FS_MAX_PATH) break; // Registro dañado
 
-        char name_buf[MAX_NAME];
+        char name_buf[FS_MAX_PATH];
         memset(name_buf,0,sizeof(name_buf)); // Limpia buffer
         fread(name_buf, 1, name_len, f);
 
         int content_len = 0;
         fread(&content_len, sizeof(int), 1, f);
+        if (content_len < -1 || content_len > EXT_MAX_SIZE) break;
+
+        make_parents(name_buf);
+        if (content_len == -1) { // Directorio
+            fs_mkdir(name_buf);
+            continue;
+        }
 
-        char content_buf[MAX_CONTENT];
-        memset(content_buf,0,sizeof(content_buf));
-        fread(content_buf, 1, content_len, f);
+        char *content_buf = malloc(content_len ? (size_t)content_len : 1);
+        if (!content_buf) break;
+        content_len = (int)fread(content_buf, 1, content_len, f);
 
-        // Reconstruye el archivo en memoria
-        fs_mkfile(name_buf);
-        fs_write(name_buf, content_buf);
+        // Reconstruye el archivo en memoria (con su longitud exacta)
+        int idx = fs_mkfile(name_buf);
+        if (idx != -1) ext_write(&files[idx].data, 0, content_buf, content_len);
+        free(content_buf);
     }
 
     fclose(f);
@@ -5,46 +5,101 @@
 // 📌 Definiciones para el Sistema de Archivos Virtual (VFS)
 // =====================================================
 
-// Número máximo de archivos que se pueden crear en el VFS
+// Capacidad inicial de la tabla de archivos (crece duplicándose)
 #define MAX_FILES 64      
 
+// Límite de archivos del VFS
+#define FS_MAX_FILES (1 << 20)
+
 // Longitud máxima permitida para el nombre de un archivo
+// (cada componente de una ruta)
 #define MAX_NAME 64       
 
-// Tamaño máximo del contenido de un archivo (en caracteres/bytes)
-#define MAX_CONTENT 2048  
+// Longitud máxima de una ruta completa
+#define FS_MAX_PATH 1024
+
+// Las entradas son inodos (archivos o directorios) dentro de un
+// árbol con raíz "/". Las rutas pueden ser absolutas o relativas al
+// directorio actual y admiten '.' y '..'; cada componente se resuelve
+// en O(1) con la caché de dentries (índice hash de (padre, nombre))
+
+// El contenido vive en un almacén de bloques con extents (ver
+// extent.h): cada archivo usa solo los bloques que necesita y puede
+// crecer hasta EXT_MAX_SIZE bytes
 
 // =====================================================
 // 📌 Prototipos de funciones del sistema de archivos
 // =====================================================
 
-// Busca un archivo por nombre. 
-// Devuelve índice si existe, -1 si no lo encuentra.
+// Busca un archivo por ruta: O(1) por componente.
+// Devuelve índice si existe, -1 si no lo encuentra o es un directorio.
 int fs_find(const char *name);
 
 // Inicializa la tabla de archivos (borra/limpia estado).
 int fs_init();
 
-// Crea un nuevo archivo con el nombre especificado.
+// Crea un nuevo archivo con el nombre especificado: O(1) amortizado.
+// Su directorio debe existir.
 // Devuelve índice del archivo o -1 si ya existe o no hay espacio.
 int fs_mkfile(const char *name);
 
-// Escribe contenido en un archivo existente.
-// Si no existe, devuelve -1.
+// Crea un directorio vacío. Devuelve su índice o -1 si ya existe,
+// falta el directorio padre o no hay espacio.
+int fs_mkdir(const char *path);
+
+// Elimina un directorio vacío (no la raíz ni el directorio actual).
+// Devuelve 0 si se eliminó, -1 si no.
+int fs_rmdir(const char *path);
+
+// Cambia el directorio actual. Devuelve 0 o -1 si no es un directorio.
+int fs_chdir(const char *path);
+
+// Copia en 'buf' la ruta absoluta del directorio actual.
+// Devuelve 0 o -1 si no entra en 'maxlen'.
+int fs_getcwd(char *buf, int maxlen);
+
+// Reemplaza el contenido de un archivo existente.
+// Si no existe (o no hay espacio), devuelve -1.
 int fs_write(const char *name, const char *content);
 
 // Lee el contenido de un archivo en el buffer 'outbuf'.
 // Máximo 'maxlen' caracteres. Devuelve 0 en éxito, -1 si no existe.
 int fs_read(const char *name, char *outbuf, int maxlen);
 
-// Lista todos los archivos almacenados en el VFS.
-void fs_ls();
+// Tamaño del archivo en bytes (-1 si no existe).
+long long fs_size(const char *name);
+
+// Acceso por desplazamiento, estilo pread / pwrite: longitudes
+// explícitas, así que los datos pueden contener bytes NUL.
+
+// Lee hasta 'n' bytes desde 'off'. Devuelve los bytes leídos
+// (0 al final del archivo) o -1 si no existe.
+long long fs_pread(const char *name, void *buf, long long n, long long off);
+
+// Escribe 'n' bytes en 'off' sin tocar el resto del archivo; si 'off'
+// pasa del final, el hueco queda con ceros. Devuelve 'n' o -1.
+long long fs_pwrite(const char *name, const void *buf, long long n, long long off);
+
+// Agrega 'n' bytes al final: O(bytes agregados). Devuelve 'n' o -1.
+long long fs_append(const char *name, const void *buf, long long n);
+
+// Cambia el tamaño del archivo (al agrandar rellena con ceros).
+// Devuelve 0 o -1.
+int fs_truncate(const char *name, long long size);
+
+// Lista un directorio (NULL = el actual) ordenado por nombre:
+// O(log N + entradas del directorio). Devuelve 0 o -1 si no existe.
+int fs_ls(const char *path);
 
-// Guarda todo el sistema de archivos en un archivo físico en disco.
-// Útil para persistencia entre ejecuciones.
+// Guarda todo el sistema de archivos en un archivo físico en disco,
+// como imagen versionada (cabecera, directorio de entradas con sus
+// offsets e índice hash de nombres). Útil para persistencia entre ejecuciones.
 int fs_save(const char *path);
 
 // Carga el sistema de archivos desde disco (archivo persistente).
+// Una imagen se mapea con mmap sin leerla: los inodos se cargan al
+// resolver rutas y el contenido al leerlo, así el arranque no depende
+// del tamaño del VFS. El formato anterior se sigue leyendo completo.
 int fs_load(const char *path);
 
 // Elimina un archivo del VFS por su nombre.
@@ -0,0 +1,103 @@
+#include <stdlib.h>     // Para malloc, free
+#include "intmap.h"     // Cabecera con la estructura IntMap
+
+// Mezcla los bits de la clave para repartir claves consecutivas
+static unsigned int mix(int key) {
+    unsigned int h = (unsigned int)key;
+    h ^= h >> 16;
+    h *= 0x7feb352dU;
+    h ^= h >> 15;
+    h *= 0x846ca68bU;
+    h ^= h >> 16;
+    return h;
+}
+
+void intmap_init(IntMap *m) {
+    m->keys = NULL;
+    m->vals = NULL;
+    m->cap = 0;
+    m->len = 0;
+}
+
+void intmap_free(IntMap *m) {
+    free(m->keys);
+    free(m->vals);
+    intmap_init(m);
+}
+
+// Reconstruye la tabla con nueva capacidad (rehash completo)
+static int intmap_grow(IntMap *m, int ncap) {
+    int *nk = malloc((size_t)ncap * sizeof(int));
+    int *nv = malloc((size_t)ncap * sizeof(int));
+    if (!nk || !nv) { free(nk); free(nv); return -1; }
+    for (int i = 0; i < ncap; ++i) nk[i] = -1;
+
+    for (int i = 0; i < m->cap; ++i) {
+        if (m->keys[i] < 0) continue;
+        unsigned int j = mix(m->keys[i]) & (unsigned int)(ncap - 1);
+        while (nk[j] >= 0) j = (j + 1) & (unsigned int)(ncap - 1);
+        nk[j] = m->keys[i];
+        nv[j] = m->vals[i];
+    }
+
+    free(m->keys);
+    free(m->vals);
+    m->keys = nk;
+    m->vals = nv;
+    m->cap = ncap;
+    return 0;
+}
+
+int intmap_put(IntMap *m, int key, int val) {
+    // Mantener factor de carga <= 1/2
+    if ((m->len + 1) * 2 > m->cap) {
+        if (intmap_grow(m, m->cap ? m->cap * 2 : 64) == -1) return -1;
+    }
+    unsigned int mask = (unsigned int)(m->cap - 1);
+    unsigned int i = mix(key) & mask;
+    while (m->keys[i] >= 0) {
+        if (m->keys[i] == key) { m->vals[i] = val; return 0; }
+        i = (i + 1) & mask;
+    }
+    m->keys[i] = key;
+    m->vals[i] = val;
+    m->len++;
+    return 0;
+}
+
+int intmap_get(const IntMap *m, int key) {
+    if (m->cap == 0 || key < 0) return -1;
+    unsigned int mask = (unsigned int)(m->cap - 1);
+    unsigned int i = mix(key) & mask;
+    while (m->keys[i] >= 0) {
+        if (m->keys[i] == key) return m->vals[i];
+        i = (i + 1) & mask;
+    }
+    return -1;
+}
+
+int intmap_del(IntMap *m, int key) {
+    if (m->cap == 0 || key < 0) return 0;
+    unsigned int mask = (unsigned int)(m->cap - 1);
+    unsigned int i = mix(key) & mask;
+    while (m->keys[i] != key) {
+        if (m->keys[i] < 0) return 0; // No estaba
+        i = (i + 1) & mask;
+    }
+
+    // Desplazar hacia atrás las entradas del mismo grupo (sin lápidas)
+    unsigned int j = i;
+    for (;;) {
+        m->keys[i] = -1;
+        for (;;) {
+            j = (j + 1) & mask;
+            if (m->keys[j] < 0) { m->len--; return 1; }
+            unsigned int home = mix(m->keys[j]) & mask;
+            // ¿La entrada j puede ocupar el hueco i sin romper su sondeo?
+            if (i <= j ? (home <= i || home > j) : (home <= i && home > j)) break;
+        }
+        m->keys[i] = m->keys[j];
+        m->vals[i] = m->vals[j];
+        i = j;
+    }
+}
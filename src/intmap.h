@@ -0,0 +1,33 @@
+#ifndef INTMAP_H
+#define INTMAP_H
+
+// =====================================================
+// 📌 Tabla hash entero → entero (direccionamiento abierto)
+// =====================================================
+// Sondeo lineal con borrado por desplazamiento hacia atrás
+// (sin lápidas), así las búsquedas siguen siendo O(1) aunque
+// haya muchas altas y bajas. Las claves deben ser >= 0.
+
+typedef struct {
+    int *keys;   // Claves (-1 = casilla vacía)
+    int *vals;   // Valores asociados
+    int cap;     // Capacidad (potencia de 2)
+    int len;     // Entradas ocupadas
+} IntMap;
+
+// Inicializa un mapa vacío (no reserva memoria todavía)
+void intmap_init(IntMap *m);
+
+// Libera la memoria del mapa y lo deja vacío
+void intmap_free(IntMap *m);
+
+// Inserta o actualiza key → val. Devuelve 0 si tuvo éxito o -1 sin memoria
+int intmap_put(IntMap *m, int key, int val);
+
+// Busca key. Devuelve su valor o -1 si no existe
+int intmap_get(const IntMap *m, int key);
+
+// Elimina key si existe. Devuelve 1 si se eliminó, 0 si no estaba
+int intmap_del(IntMap *m, int key);
+
+#endif // INTMAP_H
@@ -2,10 +2,12 @@
 #include <stdio.h>
 #include <stdarg.h>
 #include <string.h>
+#include <pthread.h>
 
 
 
 static out_sink_fn SINK = NULL;
+static pthread_mutex_t SINK_LOCK = PTHREAD_MUTEX_INITIALIZER; // Serializa salidas de varios hilos
 static log_mode_t MODE = LOG_MODE_CLI;
 
 // Convierte texto plano en formato mejorado para GUI
@@ -133,9 +135,13 @@ void outf(const char *fmt, ...) {
         // Luego aplicar formateo para GUI
         format_for_gui(clean, formatted, sizeof formatted);
 
+        pthread_mutex_lock(&SINK_LOCK);
         if (SINK) SINK(formatted); else fputs(formatted, stdout);
+        pthread_mutex_unlock(&SINK_LOCK);
     } else {
+        pthread_mutex_lock(&SINK_LOCK);
         if (SINK) SINK(buf); else fputs(buf, stdout);
+        pthread_mutex_unlock(&SINK_LOCK);
     }
 }
 
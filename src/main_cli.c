@@ -7,10 +7,11 @@
 
 static void console_sink(const char *s) { fputs(s, stdout); }
 
-int main(void) {
+int main(int argc, char **argv) {
     char line[1024];
 
     set_output(console_sink);  // manda OUT(...) a stdout
+    shell_configure(argc, argv); // --memoria <tamano>, --huge
     shell_init();              // banner + init subsistemas
 
     while (1) {
@@ -1,132 +1,964 @@
 #include <stdio.h>      // Para printf (mostrar mapa de memoria)
-#include <string.h>     // (No se usa directamente aquí, pero puede quedar para extensiones)
+#include <stdlib.h>     // Para realloc, strtoll (pool de bloques dinámico)
+#include <string.h>     // Para memmove, memcpy, memset (datos de la arena)
+#include <time.h>       // Para clock_gettime (duración de la compactación)
+#include <pthread.h>    // Lock del gestor (clientes concurrentes)
+#ifdef _WIN32
+#include <windows.h>    // Para VirtualAlloc (arena en Windows)
+#else
+#include <sys/mman.h>   // Para mmap / madvise (arena y huge pages)
+#endif
 #include "memory.h"     // Cabecera que define MemBlock, MEM_SIZE, MAX_BLOCKS, etc.
+#include "rbtree.h"    // Árbol de bloques libres por tamaño (best/worst-fit)
+#include "intmap.h"    // Índice dueño → lista de sus bloques
+#include "slab.h"      // Ocupación de las cachés slab (mem_map)
 #include "log.h"       // Módulo de logging
 
 // ======================================================
 // 📌 Variables globales
 // ======================================================
-static MemBlock blocks[MAX_BLOCKS];  // Arreglo que representa los bloques de memoria
+static MemBlock *blocks = NULL;      // Pool de bloques (índices estables)
+static int pool_cap = 0;             // Nodos reservados en el pool
+static int spare = -1;               // Nodos sin usar, encadenados por 'next'
+static int head = -1;                // Primer bloque en orden de direcciones
 static int block_count = 0;          // Cantidad actual de bloques en uso
 
+// Arena real: los bytes de la memoria simulada
+static unsigned char *arena = NULL;  // Base de la arena (NULL = sin reservar)
+static long long arena_size = 0;     // Bytes reservados
+static size_t arena_map_len = 0;     // Longitud realmente mapeada (con alineación)
+static void *arena_map_base = NULL;  // Dirección devuelta por mmap
+static int arena_huge_req = 0;       // Se pidieron huge pages
+static int arena_huge = 0;           // madvise(MADV_HUGEPAGE) aceptado
+static long long mem_size = MEM_SIZE; // Tamaño para el próximo mem_init
+static int want_huge = 0;            // Huge pages para el próximo mem_init
+
+// Listas segregadas: una lista doble de bloques libres por clase
+// de tamaño y un bitmap con un bit por clase no vacía
+static int seg_head[MEM_CLASSES];
+static unsigned long long seg_bitmap = 0;
+
+static mem_policy_t mem_policy = MEM_SEG_FIT; // Política activa
+static mem_mode_t mem_mode = MEM_MODE_LIST;   // Lista o buddy
+
+// Contabilidad de bytes ocupados: en modo buddy el bloque puede
+// ser mayor que el pedido (fragmentación interna)
+static long long bytes_alloc = 0;    // Suma de tamaños de bloques ocupados
+static long long bytes_req = 0;      // Suma de bytes pedidos
+static long long peak_alloc = 0;     // Máximo de bytes ocupados
+static long long peak_waste = 0;     // Máximo de fragmentación interna
+static int alloc_fails = 0;          // Asignaciones fallidas
+static int frag_fails = 0;           // ...con memoria libre total suficiente
+static int auto_compact = 0;         // Compactar al fallar por fragmentación
+static int compactions = 0;          // Compactaciones realizadas
+static long long moved_total = 0;    // Bytes desplazados en total
+static long long compact_ns_total = 0; // Nanosegundos compactando
+
+// Lock global del gestor: las funciones públicas de asignación,
+// liberación y acceso lo toman; las internas asumen que ya se tiene
+static pthread_mutex_t heap_lock = PTHREAD_MUTEX_INITIALIZER;
+static long long lock_acquired = 0;  // Adquisiciones (se cuentan con el lock tomado)
+static long long lock_contended = 0; // ...que encontraron el lock ocupado (atómico)
+
+// Índice por dueño: cada dueño con bloques tiene un registro con la
+// cabeza de su lista intrusiva (onext/oprev) y su ocupación. Los
+// dueños internos son negativos, así que la clave se desplaza
+typedef struct {
+    int owner;           // Dueño del registro (-1 = registro libre)
+    int head;            // Primer bloque de su lista (o siguiente libre)
+    MemOwnerUsage u;     // Bloques y bytes que ocupa
+} OwnerRec;
+
+#define OWNER_KEY(o) ((o) - MEM_OWNER_MIN)
+
+static OwnerRec *owners = NULL;      // Pool de registros (índices estables)
+static int own_len = 0, own_cap = 0;
+static int own_spare = -1;           // Registros libres, encadenados por 'head'
+static IntMap owner_index;           // OWNER_KEY(dueño) → registro
+static int owner_ready = 0;
+
+// Árbol de bloques libres ordenado por (tamaño, dirección). Solo se
+// mantiene con best-fit y worst-fit; las demás políticas no lo pagan
+static RbTree free_tree;
+static int tree_ready = 0;
+static int tree_on = 0;
+
+// Puntero itinerante de next-fit (-1 = empezar por el primero)
+static int rover = -1;
+
 // ======================================================
-// 📌 mem_init()
-// Inicializa la memoria: un solo bloque libre de tamaño MEM_SIZE
+// 📌 Funciones auxiliares del pool de bloques
 // ======================================================
-void mem_init() {
-    block_count = 1;           // Empezamos con un solo bloque
-    blocks[0].owner = -1;      // Ningún proceso dueño (sin asignar)
-    blocks[0].start = 0;       // Comienza en dirección 0
-    blocks[0].size = MEM_SIZE; // Tamaño completo de la memoria
-    blocks[0].free = 1;        // Está libre
+
+// Toma un nodo libre del pool (duplica el pool si hace falta)
+static int node_new(void) {
+    if (spare == -1) {
+        int ncap = pool_cap ? pool_cap * 2 : MAX_BLOCKS;
+        MemBlock *nb = realloc(blocks, (size_t)ncap * sizeof(MemBlock));
+        if (!nb) return -1;
+        blocks = nb;
+        for (int i = ncap - 1; i >= pool_cap; --i) {
+            blocks[i].size = 0;
+            blocks[i].next = spare;
+            spare = i;
+        }
+        pool_cap = ncap;
+    }
+    int i = spare;
+    spare = blocks[i].next;
+    block_count++;
+    return i;
+}
+
+// Devuelve un nodo al pool (size = 0 marca "nodo sin usar")
+static void node_release(int i) {
+    blocks[i].size = 0;
+    blocks[i].next = spare;
+    spare = i;
+    block_count--;
+}
+
+// Clase de tamaño: posición del bit más alto (floor(log2(size)))
+static int size_class(long long size) {
+    return 63 - __builtin_clzll((unsigned long long)size);
+}
+
+// Orden del árbol de libres: por tamaño y, a igual tamaño, por dirección
+static int free_less(int a, int b, void *ctx) {
+    (void)ctx;
+    if (blocks[a].size != blocks[b].size) return blocks[a].size < blocks[b].size;
+    return blocks[a].start < blocks[b].start;
+}
+
+// ¿El bloque es menor que el tamaño pedido? (cota inferior de best-fit)
+static int free_below(int id, const void *key) {
+    return blocks[id].size < *(const long long *)key;
+}
+
+// Vacía el árbol y decide si la política activa lo necesita
+static void tree_reset(void) {
+    if (!tree_ready) { rb_init(&free_tree, free_less, NULL); tree_ready = 1; }
+    rb_clear(&free_tree);
+    tree_on = mem_mode == MEM_MODE_LIST &&
+              (mem_policy == MEM_BEST_FIT || mem_policy == MEM_WORST_FIT);
+}
+
+// Inserta un bloque libre al frente de la lista de su clase: O(1)
+// (y en el árbol por tamaño si está activo: O(log N))
+static void seg_insert(int i) {
+    int c = size_class(blocks[i].size);
+    blocks[i].fprev = -1;
+    blocks[i].fnext = seg_head[c];
+    if (seg_head[c] != -1) blocks[seg_head[c]].fprev = i;
+    seg_head[c] = i;
+    seg_bitmap |= 1ULL << c;
+    if (tree_on) rb_insert(&free_tree, i);
+}
+
+// Quita un bloque libre de la lista de su clase: O(1)
+static void seg_remove(int i) {
+    int c = size_class(blocks[i].size);
+    if (blocks[i].fprev != -1) blocks[blocks[i].fprev].fnext = blocks[i].fnext;
+    else seg_head[c] = blocks[i].fnext;
+    if (blocks[i].fnext != -1) blocks[blocks[i].fnext].fprev = blocks[i].fprev;
+    if (seg_head[c] == -1) seg_bitmap &= ~(1ULL << c);
+    if (tree_on) rb_erase(&free_tree, i);
+}
+
+// Toma el lock global contando si hubo contención
+static void heap_enter(void) {
+    if (pthread_mutex_trylock(&heap_lock) != 0) {
+        __atomic_add_fetch(&lock_contended, 1, __ATOMIC_RELAXED);
+        pthread_mutex_lock(&heap_lock);
+    }
+    lock_acquired++;
+}
+
+static void heap_leave(void) { pthread_mutex_unlock(&heap_lock); }
+
+void mem_lock_stats(long long *acquired, long long *contended) {
+    heap_enter();
+    *acquired = lock_acquired - 1;   // Sin contar esta consulta
+    *contended = __atomic_load_n(&lock_contended, __ATOMIC_RELAXED);
+    heap_leave();
+}
+
+// Dueños válidos: procesos (>= 0) y capas internas (MEM_OWNER_*)
+static int owner_valid(int owner) {
+    return owner >= MEM_OWNER_MIN && owner != -1;
 }
 
 // ======================================================
-// 📌 mem_coalesce()
-// Función auxiliar: fusiona bloques libres adyacentes
-// para evitar fragmentación externa
+// 📌 Índice por dueño
 // ======================================================
-// Fusiona bloques de memoria libres adyacentes para reducir fragmentación externa
-static void mem_coalesce() {
-    int i = 0;
-    while (i < block_count - 1) {
-        if (blocks[i].free && blocks[i+1].free) {  // Dos bloques libres consecutivos
-            // Fusionar bloques contiguos
-            blocks[i].size += blocks[i+1].size;
 
-            // Desplazar los bloques a la izquierda
-            for (int j = i+1; j < block_count-1; ++j) {
-                blocks[j] = blocks[j+1];
-            }
+// Registro del dueño; con 'create' lo crea si no existe. -1 sin memoria
+static int owner_rec(int owner, int create) {
+    int r = intmap_get(&owner_index, OWNER_KEY(owner));
+    if (r != -1 || !create) return r;
+    if (own_spare != -1) {
+        r = own_spare;
+        own_spare = owners[r].head;
+    } else {
+        if (own_len == own_cap) {
+            int ncap = own_cap ? own_cap * 2 : 16;
+            OwnerRec *no = realloc(owners, (size_t)ncap * sizeof(OwnerRec));
+            if (!no) return -1;
+            owners = no;
+            own_cap = ncap;
+        }
+        r = own_len++;
+    }
+    if (intmap_put(&owner_index, OWNER_KEY(owner), r) == -1) {
+        owners[r].owner = -1;
+        owners[r].head = own_spare;
+        own_spare = r;
+        return -1;
+    }
+    owners[r].owner = owner;
+    owners[r].head = -1;
+    owners[r].u.blocks = 0;
+    owners[r].u.bytes = owners[r].u.used = 0;
+    return r;
+}
 
-            block_count--; // Reducimos el total de bloques
-            // No incrementamos i, revisamos de nuevo por si hay más fusiones
-        } else {
-            i++;
+// Recicla el registro r (ya sin bloques)
+static void owner_drop(int r) {
+    intmap_del(&owner_index, OWNER_KEY(owners[r].owner));
+    owners[r].owner = -1;
+    owners[r].head = own_spare;
+    own_spare = r;
+}
+
+// Engancha el bloque ocupado i al frente de la lista de su dueño: O(1)
+static void owner_link(int i) {
+    int r = owner_rec(blocks[i].owner, 0);   // Creado por mem_alloc
+    blocks[i].oprev = -1;
+    blocks[i].onext = owners[r].head;
+    if (owners[r].head != -1) blocks[owners[r].head].oprev = i;
+    owners[r].head = i;
+    owners[r].u.blocks++;
+    owners[r].u.bytes += blocks[i].size;
+    owners[r].u.used += blocks[i].used;
+}
+
+// Desengancha el bloque i de la lista de su dueño: O(1)
+static void owner_unlink(int i) {
+    int r = owner_rec(blocks[i].owner, 0);
+    if (blocks[i].oprev != -1) blocks[blocks[i].oprev].onext = blocks[i].onext;
+    else owners[r].head = blocks[i].onext;
+    if (blocks[i].onext != -1) blocks[blocks[i].onext].oprev = blocks[i].oprev;
+    owners[r].u.blocks--;
+    owners[r].u.bytes -= blocks[i].size;
+    owners[r].u.used -= blocks[i].used;
+    if (owners[r].u.blocks == 0) owner_drop(r);
+}
+
+// Vacía el índice (todos los bloques vuelven a estar libres)
+static void owner_reset(void) {
+    if (owner_ready) intmap_free(&owner_index);
+    intmap_init(&owner_index);
+    owner_ready = 1;
+    own_len = 0;
+    own_spare = -1;
+}
+
+// Registra 'size' bytes pedidos sobre el bloque 'i' recién ocupado
+static void account_alloc(int i, long long size) {
+    blocks[i].used = size;
+    owner_link(i);
+    bytes_alloc += blocks[i].size;
+    bytes_req += size;
+    if (bytes_alloc > peak_alloc) peak_alloc = bytes_alloc;
+    if (bytes_alloc - bytes_req > peak_waste) peak_waste = bytes_alloc - bytes_req;
+}
+
+// Agrega un bloque libre al final de la lista de direcciones
+static int append_free(int prev, long long start, long long size) {
+    int i = node_new();
+    if (i == -1) return -1;
+    blocks[i].owner = -1;      // Ningún proceso dueño (sin asignar)
+    blocks[i].start = start;
+    blocks[i].size = size;
+    blocks[i].free = 1;        // Está libre
+    blocks[i].used = 0;
+    blocks[i].next = -1;
+    blocks[i].prev = prev;
+    if (prev != -1) blocks[prev].next = i;
+    else head = i;
+    seg_insert(i);
+    return i;
+}
+
+// ======================================================
+// 📌 arena_map(size, huge)
+// Reserva la arena con mmap (VirtualAlloc en Windows). Con 'huge'
+// se alinea a 2 MB y se pide MADV_HUGEPAGE. Solo reemplaza la
+// arena anterior si la nueva se pudo reservar
+// ======================================================
+#define HUGE_ALIGN (2LL << 20)
+
+static void arena_unmap(void) {
+    if (!arena_map_base) return;
+#ifdef _WIN32
+    VirtualFree(arena_map_base, 0, MEM_RELEASE);
+#else
+    munmap(arena_map_base, arena_map_len);
+#endif
+    arena = NULL;
+    arena_map_base = NULL;
+    arena_map_len = 0;
+    arena_size = 0;
+}
+
+static int arena_map(long long size, int huge) {
+    void *base;
+    unsigned char *p;
+    size_t len = (size_t)size;
+    int thp = 0;
+#ifdef _WIN32
+    (void)huge; // Las large pages de Windows requieren privilegios
+    base = VirtualAlloc(NULL, len, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+    if (!base) return -1;
+    p = base;
+#else
+    if (huge) len += (size_t)HUGE_ALIGN;     // Margen para alinear a 2 MB
+    base = mmap(NULL, len, PROT_READ | PROT_WRITE,
+                MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (base == MAP_FAILED) return -1;
+    p = base;
+    if (huge) {
+        p = (unsigned char *)(((unsigned long long)p + HUGE_ALIGN - 1) & ~(unsigned long long)(HUGE_ALIGN - 1));
+#ifdef MADV_HUGEPAGE
+        thp = madvise(p, (size_t)size, MADV_HUGEPAGE) == 0;
+#endif
+    }
+#endif
+    arena_unmap();
+    arena_map_base = base;
+    arena_map_len = len;
+    arena = p;
+    arena_size = size;
+    arena_huge_req = huge;
+    arena_huge = thp;
+    return 0;
+}
+
+int mem_configure(long long size, int huge) {
+    if (size < MEM_MIN_SIZE || size > MEM_MAX_SIZE) return -1;
+    mem_size = size;
+    if (huge >= 0) want_huge = huge;  // -1: conservar lo pedido antes
+    return 0;
+}
+
+long long mem_parse_size(const char *s) {
+    char *end;
+    long long v = strtoll(s, &end, 10);
+    if (end == s || v <= 0) return -1;
+    int shift = 0;
+    switch (*end) {
+    case 'k': case 'K': shift = 10; end++; break;
+    case 'm': case 'M': shift = 20; end++; break;
+    case 'g': case 'G': shift = 30; end++; break;
+    }
+    // Rango antes de desplazar: un desplazamiento que desborda es UB
+    if (*end != '\0' || v > (MEM_MAX_SIZE >> shift)) return -1;
+    return v << shift;
+}
+
+long long mem_total(void) { return arena_size; }
+int mem_huge(void) { return arena_huge; }
+
+// ======================================================
+// 📌 mem_init()
+// Inicializa la memoria: un solo bloque libre que cubre la arena.
+// En modo buddy, el área se reparte en potencias de 2 alineadas
+// ======================================================
+int mem_init() {
+    int rc = 0;
+    if (!arena || arena_size != mem_size || arena_huge_req != want_huge) {
+        if (arena_map(mem_size, want_huge) == -1) {
+            rc = -1;
+            if (!arena && arena_map(MEM_SIZE, 0) == -1) return -1;
+            mem_size = arena_size;       // Se conserva la arena anterior
+            want_huge = arena_huge_req;
         }
     }
+
+    // Devolver todos los nodos al pool
+    spare = -1;
+    for (int i = pool_cap - 1; i >= 0; --i) {
+        blocks[i].size = 0;
+        blocks[i].next = spare;
+        spare = i;
+    }
+    block_count = 0;
+    for (int c = 0; c < MEM_CLASSES; ++c) seg_head[c] = -1;
+    seg_bitmap = 0;
+    bytes_alloc = bytes_req = 0;
+    peak_alloc = peak_waste = 0;
+    alloc_fails = frag_fails = 0;
+    compactions = 0;
+    moved_total = compact_ns_total = 0;
+    head = -1;
+    rover = -1;
+    tree_reset();
+    owner_reset();
+
+    if (mem_mode == MEM_MODE_LIST) {
+        append_free(-1, 0, arena_size);  // Empezamos con un solo bloque
+        return rc;
+    }
+    // Buddy: de mayor a menor potencia de 2, cada una alineada a su tamaño
+    long long start = 0;
+    int last = -1;
+    for (int k = MEM_CLASSES - 2; k >= MEM_BUDDY_MIN_ORDER; --k) {
+        long long size = 1LL << k;
+        if (arena_size - start >= size) {
+            last = append_free(last, start, size);
+            if (last == -1) return -1;
+            start += size;
+        }
+    }
+    return rc;
+}
+
+int mem_init_mode(mem_mode_t mode) {
+    mem_mode = mode;
+    return mem_init();
+}
+
+mem_mode_t mem_get_mode(void) { return mem_mode; }
+
+// ======================================================
+// 📌 mem_stats() / mem_reset_stats()
+// Bytes libres, mayor bloque libre, fragmentación externa,
+// picos y fallos desde el último reinicio
+// ======================================================
+void mem_stats(MemStats *st) {
+    heap_enter();
+    st->free_bytes = 0;
+    st->largest_free = 0;
+    for (int i = head; i != -1; i = blocks[i].next) {
+        if (!blocks[i].free) continue;
+        st->free_bytes += blocks[i].size;
+        if (blocks[i].size > st->largest_free) st->largest_free = blocks[i].size;
+    }
+    st->ext_frag = st->free_bytes ? 1.0 - (double)st->largest_free / (double)st->free_bytes : 0.0;
+    st->peak_alloc = peak_alloc;
+    st->peak_waste = peak_waste;
+    st->fails = alloc_fails;
+    st->frag_fails = frag_fails;
+    st->compactions = compactions;
+    st->moved_bytes = moved_total;
+    st->compact_ns = compact_ns_total;
+    heap_leave();
+}
+
+void mem_reset_stats(void) {
+    peak_alloc = bytes_alloc;
+    peak_waste = bytes_alloc - bytes_req;
+    alloc_fails = frag_fails = 0;
+    compactions = 0;
+    moved_total = compact_ns_total = 0;
+}
+
+// Absorbe el bloque j (vecino siguiente de i) dentro de i
+static void absorb_next(int i, int j) {
+    blocks[i].size += blocks[j].size;
+    blocks[i].next = blocks[j].next;
+    if (blocks[j].next != -1) blocks[blocks[j].next].prev = i;
+    if (rover == j) rover = i;       // El puntero de next-fit sigue válido
+    node_release(j);
+}
+
+// ======================================================
+// 📌 mem_coalesce(i)
+// Función auxiliar: fusiona el bloque libre i con sus
+// vecinos físicos libres para evitar fragmentación externa.
+// Solo mira prev/next, así que cuesta O(1).
+// Devuelve el índice del bloque resultante
+// ======================================================
+static int mem_coalesce(int i) {
+    int n = blocks[i].next;
+    if (n != -1 && blocks[n].free) {     // Vecino siguiente libre
+        seg_remove(n);
+        absorb_next(i, n);
+    }
+    int p = blocks[i].prev;
+    if (p != -1 && blocks[p].free) {     // Vecino anterior libre
+        seg_remove(p);
+        absorb_next(p, i);
+        i = p;
+    }
+    seg_insert(i);
+    return i;
+}
+
+// Ocupa el bloque libre i: lo saca de su lista y separa el sobrante
+static int mem_take(int i, int owner, long long size) {
+    seg_remove(i);
+    if (blocks[i].size > size) {
+        // Dividir bloque en dos (split): la cola queda libre
+        int j = node_new();
+        if (j == -1) { seg_insert(i); return -1; }
+        blocks[j].owner = -1;
+        blocks[j].start = blocks[i].start + size;
+        blocks[j].size = blocks[i].size - size;
+        blocks[j].free = 1;
+        blocks[j].next = blocks[i].next;
+        blocks[j].prev = i;
+        if (blocks[i].next != -1) blocks[blocks[i].next].prev = j;
+        blocks[i].next = j;
+        blocks[i].size = size;
+        seg_insert(j);
+    }
+    blocks[i].owner = owner;
+    blocks[i].free = 0;
+    account_alloc(i, size);
+    return i;
+}
+
+// ======================================================
+// 📌 Sistema buddy
+// Las listas segregadas hacen de listas por orden (todos los
+// bloques son potencia de 2, así la clase coincide con el orden).
+// El buddy de un bloque de tamaño 2^k en 'start' está en
+// start XOR 2^k, y por ser contiguo es su vecino prev o next.
+// ======================================================
+
+// Orden del bloque más chico que contiene 'size' bytes
+static int buddy_order(long long size) {
+    int k = (size > 1) ? 64 - __builtin_clzll((unsigned long long)(size - 1)) : 0;
+    return k < MEM_BUDDY_MIN_ORDER ? MEM_BUDDY_MIN_ORDER : k;
+}
+
+// Asignación: menor orden disponible (bitmap, O(1)) y divisiones
+// sucesivas a la mitad hasta el orden pedido: O(log N)
+static int buddy_alloc(int owner, long long size) {
+    int k = buddy_order(size);
+    if (k >= MEM_CLASSES - 1) return -1;
+    unsigned long long avail = seg_bitmap & ~((1ULL << k) - 1);
+    if (!avail) return -1;
+
+    int j = __builtin_ctzll(avail);
+    int i = seg_head[j];
+    seg_remove(i);
+    while (j > k) {
+        // La mitad superior queda libre como buddy del bloque
+        j--;
+        int b = node_new();
+        if (b == -1) { seg_insert(i); return -1; }
+        blocks[b].owner = -1;
+        blocks[b].start = blocks[i].start + (1LL << j);
+        blocks[b].size = 1LL << j;
+        blocks[b].free = 1;
+        blocks[b].used = 0;
+        blocks[b].next = blocks[i].next;
+        blocks[b].prev = i;
+        if (blocks[i].next != -1) blocks[blocks[i].next].prev = b;
+        blocks[i].next = b;
+        blocks[i].size = 1LL << j;
+        seg_insert(b);
+    }
+    blocks[i].owner = owner;
+    blocks[i].free = 0;
+    account_alloc(i, size);
+    return i;
+}
+
+// Liberación: fusiona con su buddy mientras esté libre y entero: O(log N)
+static int buddy_coalesce(int i) {
+    for (;;) {
+        long long size = blocks[i].size;
+        long long addr = blocks[i].start ^ size;     // Dirección del buddy
+        int b = addr > blocks[i].start ? blocks[i].next : blocks[i].prev;
+        if (b == -1 || !blocks[b].free || blocks[b].size != size || blocks[b].start != addr) break;
+        seg_remove(b);
+        if (addr > blocks[i].start) absorb_next(i, b);
+        else { absorb_next(b, i); i = b; }
+    }
+    seg_insert(i);
+    return i;
+}
+
+// First-Fit: primer bloque libre suficiente en orden de direcciones: O(N)
+static int find_first_fit(long long size) {
+    for (int i = head; i != -1; i = blocks[i].next)
+        if (blocks[i].free && blocks[i].size >= size) return i;
+    return -1;
+}
+
+// Best-fit: cota inferior por tamaño en el árbol, O(log N)
+static int find_best_fit(long long size) {
+    return rb_lower_bound(&free_tree, free_below, &size);
+}
+
+// Worst-fit: el máximo del árbol, O(log N)
+static int find_worst_fit(long long size) {
+    int i = rb_last(&free_tree);
+    return (i != -1 && blocks[i].size >= size) ? i : -1;
+}
+
+// Next-fit: first-fit que arranca donde quedó la búsqueda anterior
+static int find_next_fit(long long size) {
+    int start = (rover != -1) ? rover : head;
+    int i = start;
+    do {
+        if (blocks[i].free && blocks[i].size >= size) return i;
+        i = blocks[i].next;
+        if (i == -1) i = head;           // Vuelta al principio
+    } while (i != start);
+    return -1;
+}
+
+// Ajuste segregado: cualquier bloque de una clase mayor que la del
+// pedido sirve seguro, y el bitmap da la menor de ellas en O(1).
+// Si no hay, se recorre la lista de la propia clase
+static int find_seg_fit(long long size) {
+    int c = size_class(size);
+    unsigned long long above = (c + 1 < MEM_CLASSES) ? seg_bitmap & ~((2ULL << c) - 1) : 0;
+    if (above) return seg_head[__builtin_ctzll(above)];
+    for (int i = seg_head[c]; i != -1; i = blocks[i].fnext)
+        if (blocks[i].size >= size) return i;
+    return -1;
 }
 
 // ======================================================
 // 📌 mem_alloc(owner, size)
-// Implementa "first-fit": busca el primer bloque libre
-// suficientemente grande y asigna la memoria.
+// Busca un bloque libre según la política activa y asigna
+// la memoria, dividiendo el bloque si sobra espacio.
 // Devuelve el índice del bloque asignado o -1 si falla.
 // ======================================================
-// Asigna un bloque de memoria usando el algoritmo First-Fit
-// Busca el primer bloque libre suficientemente grande
-int mem_alloc(int owner, int size) {
-    if (size <= 0 || size > MEM_SIZE) return -1;  // Validar tamaño
-
-    for (int i = 0; i < block_count; ++i) {
-        if (blocks[i].free && blocks[i].size >= size) {
-            // Caso 1: tamaño exacto → asignar directamente
-            if (blocks[i].size == size) {
-                blocks[i].owner = owner;
-                blocks[i].free = 0;
-                return i;
-            }
-            // Caso 2: dividir bloque en dos (split)
-            else {
-                if (block_count >= MAX_BLOCKS) return -1; // No hay espacio en tabla
+static int compact_locked(MemCompactResult *out);
+
+static int alloc_locked(int owner, long long size) {
+    if (size <= 0 || size > arena_size) return -1;  // Validar tamaño
+    if (!owner_valid(owner)) return -1;
+    int r = owner_rec(owner, 1);     // El registro debe existir antes de enlazar
+    if (r == -1) return -1;
+
+    int i;
+    if (mem_mode == MEM_MODE_BUDDY) {
+        i = buddy_alloc(owner, size);
+    } else {
+        switch (mem_policy) {
+        case MEM_FIRST_FIT: i = find_first_fit(size); break;
+        case MEM_BEST_FIT:  i = find_best_fit(size);  break;
+        case MEM_WORST_FIT: i = find_worst_fit(size); break;
+        case MEM_NEXT_FIT:  i = find_next_fit(size);  break;
+        default:            i = find_seg_fit(size);   break;
+        }
+        if (i == -1 && auto_compact && size <= arena_size - bytes_alloc && compact_locked(NULL) == 0)
+            i = find_first_fit(size);    // Tras compactar, lo libre está al final
+        if (i != -1) i = mem_take(i, owner, size);
+        if (i != -1 && mem_policy == MEM_NEXT_FIT) rover = i;
+    }
+    if (i == -1) {
+        // No se encontró ajuste: ¿faltaba memoria o estaba fragmentada?
+        alloc_fails++;
+        if (size <= arena_size - bytes_alloc) frag_fails++;
+        if (owners[r].u.blocks == 0) owner_drop(r);
+    }
+    return i;
+}
 
-                // Desplazar bloques hacia la derecha para insertar el nuevo
-                for (int j = block_count; j > i+1; --j) {
-                    blocks[j] = blocks[j-1];
-                }
+int mem_alloc(int owner, long long size) {
+    heap_enter();
+    int i = alloc_locked(owner, size);
+    heap_leave();
+    return i;
+}
 
-                // Configurar el nuevo bloque (cola)
-                blocks[i+1].owner = -1;
-                blocks[i+1].start = blocks[i].start + size;
-                blocks[i+1].size = blocks[i].size - size;
-                blocks[i+1].free = 1;
+// ======================================================
+// 📌 mem_free_block(idx)
+// Libera un bloque ocupado y lo fusiona con sus vecinos: O(1)
+// ======================================================
+// Marca libre el bloque i y lo fusiona; devuelve el bloque resultante
+static int mem_release(int i) {
+    owner_unlink(i);
+    bytes_alloc -= blocks[i].size;
+    bytes_req -= blocks[i].used;
+    blocks[i].free = 1;
+    blocks[i].owner = -1;
+    blocks[i].used = 0;
+    if (mem_mode == MEM_MODE_BUDDY) return buddy_coalesce(i);
+    return mem_coalesce(i); // Reunir con los bloques contiguos libres
+}
 
-                block_count++;
+// Indica si idx es un bloque ocupado
+static int block_busy(int idx) {
+    return idx >= 0 && idx < pool_cap && blocks[idx].size != 0 && !blocks[idx].free;
+}
 
-                // Configurar el bloque asignado (cabeza)
-                blocks[i].size = size;
-                blocks[i].owner = owner;
-                blocks[i].free = 0;
+int mem_free_block(int idx) {
+    heap_enter();
+    int ok = block_busy(idx);
+    if (ok) mem_release(idx);
+    heap_leave();
+    return ok ? 0 : -1;
+}
 
-                return i;
+int mem_block_owner(int idx) {
+    heap_enter();
+    int owner = block_busy(idx) ? blocks[idx].owner : -1;
+    heap_leave();
+    return owner;
+}
+
+long long mem_block_start(int idx) {
+    heap_enter();
+    long long start = block_busy(idx) ? blocks[idx].start : -1;
+    heap_leave();
+    return start;
+}
+
+// ======================================================
+// 📌 mem_write() / mem_read()
+// Copian datos reales dentro de la arena. El bloque debe ser del
+// dueño indicado y el rango no puede pasar de los bytes pedidos
+// (el sobrante de un bloque buddy no es accesible)
+// ======================================================
+static int check_range(int owner, int idx, long long off, long long n) {
+    if (!arena) return MEM_ERR_ARENA;
+    if (owner < 0 || !block_busy(idx) || blocks[idx].owner != owner) return MEM_ERR_BLOCK;
+    if (off < 0 || n < 0 || off > blocks[idx].used || n > blocks[idx].used - off) return MEM_ERR_BOUNDS;
+    return 0;
+}
+
+// La copia se hace con el lock tomado: una compactación concurrente
+// podría mover el bloque
+int mem_write(int owner, int idx, long long off, const void *src, long long n) {
+    heap_enter();
+    int rc = check_range(owner, idx, off, n);
+    if (rc == 0) memcpy(arena + blocks[idx].start + off, src, (size_t)n);
+    heap_leave();
+    return rc;
+}
+
+int mem_read(int owner, int idx, long long off, void *dst, long long n) {
+    heap_enter();
+    int rc = check_range(owner, idx, off, n);
+    if (rc == 0) memcpy(dst, arena + blocks[idx].start + off, (size_t)n);
+    heap_leave();
+    return rc;
+}
+
+static volatile unsigned long long bw_sink;  // Destino de la suma de mem_bandwidth
+
+// ======================================================
+// 📌 mem_bandwidth(passes, write_gbs, read_gbs)
+// Recorre los bloques de procesos en orden de direcciones: primero
+// los escribe (memset) y luego los lee palabra a palabra. Los de las
+// capas internas (slab, paginación, caché por hilo) no se tocan, y
+// todo se hace con el lock tomado para que nadie los mueva ni libere
+// ======================================================
+static double elapsed_s(const struct timespec *a, const struct timespec *b) {
+    return (double)(b->tv_sec - a->tv_sec) + (double)(b->tv_nsec - a->tv_nsec) / 1e9;
+}
+
+// Bloque que mem_bandwidth puede sobrescribir: ocupado y de un proceso
+static int bw_block(int i) {
+    return !blocks[i].free && blocks[i].owner >= 0;
+}
+
+long long mem_bandwidth(int passes, double *write_gbs, double *read_gbs) {
+    *write_gbs = *read_gbs = 0.0;
+    if (passes <= 0) return 0;
+    heap_enter();
+    long long bytes = 0;
+    if (arena)
+        for (int i = head; i != -1; i = blocks[i].next)
+            if (bw_block(i)) bytes += blocks[i].size;
+    if (bytes == 0) { heap_leave(); return 0; }
+
+    struct timespec t0, t1, t2;
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    for (int p = 0; p < passes; ++p)
+        for (int i = head; i != -1; i = blocks[i].next)
+            if (bw_block(i)) memset(arena + blocks[i].start, p + 1, (size_t)blocks[i].size);
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    unsigned long long sum = 0;
+    for (int p = 0; p < passes; ++p) {
+        for (int i = head; i != -1; i = blocks[i].next) {
+            if (!bw_block(i)) continue;
+            const unsigned char *b = arena + blocks[i].start;
+            long long n = blocks[i].size, k = 0;
+            for (; k + 8 <= n; k += 8) {
+                unsigned long long w;
+                memcpy(&w, b + k, 8);
+                sum += w;
             }
+            for (; k < n; ++k) sum += b[k];
         }
     }
-    return -1; // No se encontró ajuste adecuado
+    clock_gettime(CLOCK_MONOTONIC, &t2);
+    heap_leave();
+    bw_sink = sum;  // Evita que el compilador descarte la lectura
+
+    double total = (double)bytes * passes / 1e9;
+    double ws = elapsed_s(&t0, &t1), rs = elapsed_s(&t1, &t2);
+    *write_gbs = ws > 0 ? total / ws : 0.0;
+    *read_gbs = rs > 0 ? total / rs : 0.0;
+    return bytes;
 }
 
 // ======================================================
 // 📌 mem_free_by_owner(owner)
-// Libera todos los bloques pertenecientes a un proceso.
+// Libera todos los bloques pertenecientes a un proceso
+// recorriendo solo su lista: O(bloques del dueño).
 // Devuelve cuántos bloques fueron liberados.
 // ======================================================
 int mem_free_by_owner(int owner) {
-    int freed = 0;
-    for (int i = 0; i < block_count; ++i) {
-        if (!blocks[i].free && blocks[i].owner == owner) {
-            blocks[i].free = 1;
-            blocks[i].owner = -1;
-            freed++;
+    if (!owner_valid(owner)) return 0;
+    heap_enter();
+    int r = owner_rec(owner, 0);
+    int freed = r != -1 ? owners[r].u.blocks : 0;
+    // Cada liberación saca la cabeza de la lista; con el último
+    // bloque el registro se recicla, por eso se cuenta antes
+    for (int k = 0; k < freed; ++k)
+        mem_release(owners[r].head);   // Puede absorber a sus vecinos (O(1))
+    heap_leave();
+    return freed;
+}
+
+int mem_owner_usage(int owner, MemOwnerUsage *out) {
+    heap_enter();
+    int r = owner_valid(owner) ? owner_rec(owner, 0) : -1;
+    int n = r != -1 ? owners[r].u.blocks : 0;
+    if (out) {
+        if (r != -1) *out = owners[r].u;
+        else { out->blocks = 0; out->bytes = out->used = 0; }
+    }
+    heap_leave();
+    return n;
+}
+
+// ======================================================
+// 📌 mem_compact(out)
+// Recorre los bloques en orden de direcciones una sola vez: los
+// ocupados se deslizan hasta 'cursor' (conservando su índice) y
+// los libres vuelven al pool. Al final queda un bloque libre único
+// ======================================================
+static int compact_locked(MemCompactResult *out) {
+    if (mem_mode == MEM_MODE_BUDDY) return -1;
+
+    struct timespec t0, t1;
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+
+    long long cursor = 0, bytes = 0;
+    int last = -1, moved = 0;
+    int i = head;
+    while (i != -1) {
+        int nxt = blocks[i].next;
+        if (blocks[i].free) {
+            seg_remove(i);
+            node_release(i);
+        } else {
+            if (blocks[i].start != cursor) {
+                moved++;
+                bytes += blocks[i].size;
+                // Hacia direcciones menores: memmove es seguro aunque se solapen
+                if (arena) memmove(arena + cursor, arena + blocks[i].start, (size_t)blocks[i].size);
+                blocks[i].start = cursor;
+            }
+            cursor += blocks[i].size;
+            blocks[i].prev = last;
+            if (last != -1) blocks[last].next = i;
+            else head = i;
+            last = i;
         }
+        i = nxt;
     }
-    if (freed > 0) mem_coalesce(); // Reunir bloques contiguos libres
-    return freed;
+    if (last != -1) blocks[last].next = -1;
+    else head = -1;
+    if (cursor < arena_size) append_free(last, cursor, arena_size - cursor);
+    rover = -1;
+
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    long long ns = (long long)(t1.tv_sec - t0.tv_sec) * 1000000000LL + (t1.tv_nsec - t0.tv_nsec);
+    compactions++;
+    moved_total += bytes;
+    compact_ns_total += ns;
+    if (out) {
+        out->moved_blocks = moved;
+        out->moved_bytes = bytes;
+        out->ns = ns;
+    }
+    return 0;
+}
+
+int mem_compact(MemCompactResult *out) {
+    heap_enter();
+    int rc = compact_locked(out);
+    heap_leave();
+    return rc;
+}
+
+void mem_set_auto_compact(int on) { auto_compact = on; }
+int mem_auto_compact(void) { return auto_compact; }
+
+// ======================================================
+// 📌 mem_set_policy(policy) / mem_get_policy()
+// Al cambiar de política se reconstruye el árbol de libres si hace falta: O(N log N)
+void mem_set_policy(mem_policy_t policy) {
+    mem_policy = policy;
+    rover = -1;
+    tree_reset();
+    if (!tree_on) return;
+    for (int i = head; i != -1; i = blocks[i].next)
+        if (blocks[i].free) rb_insert(&free_tree, i);
+}
+mem_policy_t mem_get_policy(void) { return mem_policy; }
+
+const char *mem_policy_name(mem_policy_t policy) {
+    switch (policy) {
+    case MEM_FIRST_FIT: return "first-fit";
+    case MEM_SEG_FIT:   return "segregada";
+    case MEM_BEST_FIT:  return "best-fit";
+    case MEM_WORST_FIT: return "worst-fit";
+    case MEM_NEXT_FIT:  return "next-fit";
+    }
+    return "?";
 }
 
 // ======================================================
 // 📌 mem_map()
-// Imprime el estado actual de la memoria: índice, inicio,
-// tamaño, si está libre y el PID dueño.
+// Imprime el estado actual de la memoria en orden de
+// direcciones: índice, inicio, tamaño, si está libre y el PID dueño.
 // ======================================================
 void mem_map() {
-    Mostrar("Mapa de memoria (total %d bytes):\n", MEM_SIZE);
-    Mostrar("Idx\tStart\tSize\tFree\tOwner\n");
-    for (int i = 0; i < block_count; ++i) {
-        Mostrar("%d\t%d\t%d\t%d\t%d\n",
+    const char *thp = arena_huge ? ", huge pages" : "";
+    if (mem_mode == MEM_MODE_BUDDY)
+        Mostrar("Mapa de memoria (total %lld bytes%s, %d bloques, modo buddy):\n",
+               arena_size, thp, block_count);
+    else
+        Mostrar("Mapa de memoria (total %lld bytes%s, %d bloques, politica %s):\n",
+               arena_size, thp, block_count, mem_policy_name(mem_policy));
+    Mostrar("Idx\tStart\tSize\tFree\tOwner\tUsed\n");
+    for (int i = head; i != -1; i = blocks[i].next) {
+        Mostrar("%d\t%lld\t%lld\t%d\t%d\t%lld\n",
                i,
                blocks[i].start,
                blocks[i].size,
                blocks[i].free,
-               blocks[i].owner);
+               blocks[i].owner,
+               blocks[i].used);
     }
+    // Fragmentación interna: bytes asignados que nadie pidió
+    long long waste = bytes_alloc - bytes_req;
+    Mostrar("Ocupado: %lld bytes (pedidos %lld), fragmentacion interna %lld bytes (%.1f%%)\n",
+           bytes_alloc, bytes_req, waste,
+           bytes_alloc ? 100.0 * (double)waste / (double)bytes_alloc : 0.0);
+    // Fragmentación externa: libre total repartido en bloques chicos
+    MemStats st;
+    mem_stats(&st);
+    Mostrar("Libre: %lld bytes, mayor bloque libre %lld, fragmentacion externa %.1f%%\n",
+           st.free_bytes, st.largest_free, 100.0 * st.ext_frag);
+    Mostrar("Fallos de asignacion: %d (%d con memoria libre total suficiente)\n",
+           st.fails, st.frag_fails);
+    if (st.compactions > 0)
+        Mostrar("Compactaciones: %d (%lld bytes movidos, %lld ns)\n",
+               st.compactions, st.moved_bytes, st.compact_ns);
+    slab_map();
 }
@@ -5,38 +5,195 @@
 // 📌 Definiciones para el Administrador de Memoria
 // =====================================================
 
-// Tamaño total de la memoria simulada (en bytes)
+// Tamaño por defecto de la memoria simulada (en bytes). El tamaño
+// real se elige al arrancar (--memoria) o con ReiniciarMemoria
 #define MEM_SIZE 4096   
 
-// Número máximo de bloques de memoria que pueden gestionarse
+// Límites del tamaño configurable (la arena se reserva con mmap
+// sin comprometer páginas: solo ocupan RAM las que se tocan)
+#define MEM_MIN_SIZE 64
+#define MEM_MAX_SIZE (1LL << 40)
+
+// Capacidad inicial del pool de bloques (crece bajo demanda)
 #define MAX_BLOCKS 64   
 
+// Clases de tamaño de las listas segregadas: clase c = [2^c, 2^(c+1))
+#define MEM_CLASSES 64
+
+// Dueño de las páginas tomadas por la capa slab (ver slab.h)
+#define MEM_OWNER_SLAB (-2)
+
+// Dueño del pool de marcos de la paginación (ver paging.h)
+#define MEM_OWNER_PAGING (-3)
+
+// Dueño de los spans de las cachés por hilo (ver tcache.h)
+#define MEM_OWNER_TCACHE (-4)
+
+// Menor dueño válido (los dueños internos son negativos)
+#define MEM_OWNER_MIN MEM_OWNER_TCACHE
+
+// Orden mínimo del modo buddy: bloques de al menos 2^4 = 16 bytes
+#define MEM_BUDDY_MIN_ORDER 4
+
+// Modo del administrador (se elige al inicializar la memoria)
+typedef enum {
+    MEM_MODE_LIST = 0,   // Bloques de tamaño exacto con división y fusión libres
+    MEM_MODE_BUDDY = 1   // Sistema buddy binario: bloques potencia de 2
+} mem_mode_t;
+
+// Políticas de asignación (modo lista)
+typedef enum {
+    MEM_FIRST_FIT = 0,   // Primer bloque libre suficiente en orden de direcciones
+    MEM_SEG_FIT = 1,     // Listas libres por clase de tamaño + bitmap (por defecto)
+    MEM_BEST_FIT = 2,    // Menor bloque suficiente (árbol por tamaño, O(log N))
+    MEM_WORST_FIT = 3,   // Mayor bloque libre (árbol por tamaño, O(log N))
+    MEM_NEXT_FIT = 4     // First-fit desde donde terminó la búsqueda anterior
+} mem_policy_t;
+
+// Estadísticas del administrador (ver mem_stats)
+typedef struct {
+    long long free_bytes;   // Bytes libres en total
+    long long largest_free; // Mayor bloque libre
+    double ext_frag;        // Fragmentación externa: 1 - mayor libre / libre total
+    long long peak_alloc;   // Pico de bytes ocupados
+    long long peak_waste;   // Pico de fragmentación interna (ocupado - pedido)
+    int fails;              // Asignaciones fallidas
+    int frag_fails;         // ...de ellas, con memoria libre total suficiente
+    int compactions;        // Compactaciones realizadas
+    long long moved_bytes;  // Bytes desplazados por las compactaciones
+    long long compact_ns;   // Tiempo total compactando (nanosegundos)
+} MemStats;
+
+// Resultado de una compactación
+typedef struct {
+    int moved_blocks;       // Bloques que cambiaron de dirección
+    long long moved_bytes;  // Bytes desplazados
+    long long ns;           // Tiempo empleado (nanosegundos)
+} MemCompactResult;
+
 // =====================================================
 // 📌 Estructura de un bloque de memoria
 // =====================================================
+// Los bloques viven en un pool con índices estables: dividir o
+// fusionar solo reengancha enlaces, nunca desplaza el arreglo.
+// 'prev'/'next' hacen de etiquetas de frontera (boundary tags):
+// desde cualquier bloque se llega a sus vecinos físicos en O(1).
 typedef struct {
-    int owner;   // ID del proceso propietario del bloque (-1 si está libre)
-    int start;   // Dirección inicial (offset en la memoria simulada)
-    int size;    // Tamaño del bloque en bytes
-    int free;    // Estado del bloque: 1 = libre, 0 = ocupado
+    int owner;        // ID del proceso propietario del bloque (-1 si está libre)
+    long long start;  // Dirección inicial (offset dentro de la arena)
+    long long size;   // Tamaño del bloque en bytes
+    int free;         // Estado del bloque: 1 = libre, 0 = ocupado
+    long long used;   // Bytes pedidos (size - used = fragmentación interna)
+    int next;         // Siguiente bloque en orden de direcciones (-1 = último)
+    int prev;         // Bloque anterior en orden de direcciones (-1 = primero)
+    int fnext;        // Siguiente libre de la misma clase (-1 = ninguno)
+    int fprev;        // Anterior libre de la misma clase (-1 = ninguno)
+    int onext;        // Siguiente bloque del mismo dueño (-1 = ninguno)
+    int oprev;        // Anterior bloque del mismo dueño (-1 = ninguno)
 } MemBlock;
 
+// Ocupación de un dueño (ver mem_owner_usage)
+typedef struct {
+    int blocks;       // Bloques ocupados
+    long long bytes;  // Bytes de esos bloques
+    long long used;   // Bytes pedidos (bytes - used = fragmentación interna)
+} MemOwnerUsage;
+
 // =====================================================
 // 📌 Funciones de gestión de memoria
 // =====================================================
 
-// Inicializa la memoria con un único bloque libre (MEM_SIZE completo)
-void mem_init();
+// Errores de mem_read / mem_write
+#define MEM_ERR_BLOCK  (-1)   // El bloque no existe o no es del dueño
+#define MEM_ERR_BOUNDS (-2)   // El rango se sale de los bytes pedidos
+#define MEM_ERR_ARENA  (-3)   // No hay arena reservada
+
+// Elige el tamaño de la arena (y si pedir huge pages transparentes;
+// con huge = -1 se conserva lo pedido antes) para el próximo mem_init.
+// Devuelve 0 o -1 si el tamaño es inválido
+int mem_configure(long long size, int huge);
 
-// Asigna memoria usando estrategia First-Fit.
+// Convierte "4096", "64K", "256M" o "2G" a bytes (-1 si no es válido)
+long long mem_parse_size(const char *s);
+
+// Inicializa la memoria con un único bloque libre del tamaño
+// configurado, conservando el modo actual. Si la arena no se pudo
+// reservar conserva la anterior y devuelve -1
+int mem_init();
+
+// Reinicia la memoria en el modo indicado (descarta toda asignación)
+int mem_init_mode(mem_mode_t mode);
+mem_mode_t mem_get_mode(void);
+
+// Tamaño de la arena actual y si usa huge pages transparentes
+long long mem_total(void);
+int mem_huge(void);
+
+// Estadísticas actuales (recorre los bloques: O(N)). Los picos y
+// los fallos cuentan desde el último mem_reset_stats o mem_init
+void mem_stats(MemStats *st);
+void mem_reset_stats(void);
+
+// Concurrencia: mem_alloc, mem_free_block, mem_free_by_owner,
+// mem_owner_usage, mem_block_*, mem_read/mem_write, mem_compact y
+// mem_stats toman un lock global y se pueden llamar desde varios
+// hilos. Inicializar, cambiar de política o mostrar el mapa no.
+
+// Adquisiciones del lock global y cuántas lo encontraron ocupado
+void mem_lock_stats(long long *acquired, long long *contended);
+
+// Asigna memoria según la política activa.
 // Devuelve el índice del bloque asignado o -1 si falla.
-int mem_alloc(int owner, int size);
+int mem_alloc(int owner, long long size);
+
+// Libera un bloque y lo fusiona con sus vecinos libres: O(1).
+// Devuelve 0 si tuvo éxito o -1 si el índice no es un bloque ocupado
+int mem_free_block(int idx);
 
 // Libera todos los bloques pertenecientes al proceso (owner).
+// Recorre solo la lista del dueño: O(bloques del dueño).
 // Devuelve la cantidad de bloques liberados.
 int mem_free_by_owner(int owner);
 
-// Imprime un mapa detallado del estado de la memoria (bloques).
+// Ocupación actual de un dueño: O(1). Devuelve sus bloques (0 si no
+// tiene ninguno); 'out' puede ser NULL
+int mem_owner_usage(int owner, MemOwnerUsage *out);
+
+// Dueño y dirección de un bloque ocupado (-1 si el índice no lo es).
+// El índice de bloque hace de handle: la compactación mueve los
+// bloques pero conserva sus índices, así que la dirección actual
+// debe consultarse siempre con mem_block_start
+int mem_block_owner(int idx);
+long long mem_block_start(int idx);
+
+// Copian 'n' bytes hacia / desde el bloque 'idx' a partir de 'off'.
+// El bloque debe pertenecer a 'owner' y el rango caber en los bytes
+// que pidió. Devuelven 0 o un MEM_ERR_*
+int mem_write(int owner, int idx, long long off, const void *src, long long n);
+int mem_read(int owner, int idx, long long off, void *dst, long long n);
+
+// Escribe y luego lee los bloques de procesos 'passes' veces y mide
+// el ancho de banda real (GB/s). Sobrescribe su contenido; los bloques
+// de las capas internas no se tocan. Devuelve los bytes por pasada
+long long mem_bandwidth(int passes, double *write_gbs, double *read_gbs);
+
+// Compacta la memoria en una pasada lineal: desliza los bloques
+// ocupados hacia la dirección 0 y junta todo lo libre en un único
+// bloque final. Devuelve 0 o -1 en modo buddy (rompería la alineación)
+int mem_compact(MemCompactResult *out);
+
+// Activa / consulta la compactación automática cuando una
+// asignación falla habiendo memoria libre total suficiente
+void mem_set_auto_compact(int on);
+int mem_auto_compact(void);
+
+// Imprime un mapa detallado del estado de la memoria (bloques)
+// y la ocupación de las cachés slab.
 void mem_map();
 
+// Cambia / consulta la política de asignación y su nombre
+void mem_set_policy(mem_policy_t policy);
+mem_policy_t mem_get_policy(void);
+const char *mem_policy_name(mem_policy_t policy);
+
 #endif // MEMORY_H
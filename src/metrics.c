@@ -0,0 +1,73 @@
+#include <stdlib.h>     // Para realloc, free, qsort
+#include "metrics.h"    // Cabecera con MetricSet y MetricSummary
+
+void metric_init(MetricSet *m) {
+    m->vals = NULL;
+    m->len = 0;
+    m->cap = 0;
+    m->sum = 0;
+    m->dropped = 0;
+}
+
+void metric_free(MetricSet *m) {
+    free(m->vals);
+    metric_init(m);
+}
+
+void metric_reset(MetricSet *m) {
+    m->len = 0;
+    m->sum = 0;
+    m->dropped = 0;
+}
+
+// ======================================================
+// 📌 metric_reserve(m, n)
+// Crece al doble hasta cubrir 'n' muestras (amortizado)
+// ======================================================
+int metric_reserve(MetricSet *m, int n) {
+    if (n <= m->cap) return 0;
+    int ncap = m->cap ? m->cap : 64;
+    while (ncap < n) ncap *= 2;
+    long long *nv = realloc(m->vals, (size_t)ncap * sizeof(long long));
+    if (!nv) return -1;
+    m->vals = nv;
+    m->cap = ncap;
+    return 0;
+}
+
+void metric_add(MetricSet *m, long long v) {
+    if (m->len == m->cap) { m->dropped++; return; } // Nunca reserva aquí
+    m->vals[m->len++] = v;
+    m->sum += v;
+}
+
+static int cmp_ll(const void *a, const void *b) {
+    long long x = *(const long long *)a, y = *(const long long *)b;
+    return (x > y) - (x < y);
+}
+
+// Percentil por rango más cercano sobre muestras ya ordenadas
+static long long rank(const MetricSet *m, int pct) {
+    int k = (int)(((long long)pct * m->len + 99) / 100);
+    if (k < 1) k = 1;
+    return m->vals[k - 1];
+}
+
+// ======================================================
+// 📌 metric_summary(m, out)
+// Ordena las muestras y obtiene media, p50, p95, p99 y máximo
+// ======================================================
+void metric_summary(MetricSet *m, MetricSummary *out) {
+    out->n = m->len;
+    if (m->len == 0) {
+        out->mean = 0.0;
+        out->p50 = out->p95 = out->p99 = out->max = 0;
+        return;
+    }
+    qsort(m->vals, (size_t)m->len, sizeof(long long), cmp_ll);
+    out->mean = (double)m->sum / m->len;
+    out->p50 = rank(m, 50);
+    out->p95 = rank(m, 95);
+    out->p99 = rank(m, 99);
+    out->max = m->vals[m->len - 1];
+}
@@ -0,0 +1,48 @@
+#ifndef METRICS_H
+#define METRICS_H
+
+// =====================================================
+// 📌 Conjuntos de muestras para métricas de planificación
+// =====================================================
+// La memoria se reserva de antemano (metric_reserve) fuera del
+// camino caliente; registrar una muestra es O(1) y nunca reserva.
+// Los percentiles se calculan al final ordenando las muestras.
+
+typedef struct {
+    long long *vals;   // Muestras registradas
+    int len;           // Muestras en uso
+    int cap;           // Capacidad reservada
+    long long sum;     // Suma acumulada (para la media)
+    long long dropped; // Muestras descartadas por falta de espacio
+} MetricSet;
+
+// Resumen estadístico de un conjunto
+typedef struct {
+    int n;             // Cantidad de muestras
+    double mean;       // Media
+    long long p50;     // Mediana
+    long long p95;     // Percentil 95
+    long long p99;     // Percentil 99
+    long long max;     // Máximo
+} MetricSummary;
+
+// Inicializa un conjunto vacío (no reserva memoria todavía)
+void metric_init(MetricSet *m);
+
+// Libera la memoria del conjunto y lo deja vacío
+void metric_free(MetricSet *m);
+
+// Descarta las muestras conservando la memoria reservada
+void metric_reset(MetricSet *m);
+
+// Asegura espacio para al menos 'n' muestras en total.
+// Devuelve 0 si tuvo éxito o -1 sin memoria
+int metric_reserve(MetricSet *m, int n);
+
+// Registra una muestra: O(1), sin reservar memoria
+void metric_add(MetricSet *m, long long v);
+
+// Calcula media y percentiles (reordena las muestras): O(n log n)
+void metric_summary(MetricSet *m, MetricSummary *out);
+
+#endif // METRICS_H
@@ -0,0 +1,462 @@
+#include <stdio.h>      // Para fopen, fgets, sscanf (cadenas de referencias)
+#include <stdlib.h>     // Para malloc, realloc, free
+#include <time.h>       // Para clock_gettime (velocidad de traducción)
+#include "paging.h"     // Cabecera con PAGE_SIZE, PagingStats, etc.
+#include "memory.h"     // Pool de marcos tomado de la memoria simulada
+#include "intmap.h"     // Índice PID → espacio de direcciones
+#include "process.h"    // proc_trace (detalle por acceso)
+#include "log.h"        // Módulo de logging
+
+// Resultado de una traducción
+enum { XL_TLB = 0, XL_TABLE = 1, XL_FAULT = 2, XL_INVALID = 3 };
+
+// Accesos seguidos de un mismo proceso en las referencias sintéticas
+#define SYN_BURST 1000
+// Ventana de páginas calientes y cada cuánto se desplaza
+#define SYN_WINDOW 8
+#define SYN_SHIFT 4096
+// Dueño de los espacios sintéticos: no están en el índice de PID, así
+// que ningún proceso real puede heredarlos
+#define SYN_PID (-2)
+
+// ======================================================
+// 📌 Estructuras
+// ======================================================
+typedef struct {
+    int pid;          // Proceso dueño (-1 = espacio libre, SYN_PID = sintético)
+    int *pte;         // pte[vpn] = marco o -1 si no está presente
+    int resident;     // Páginas presentes en marcos
+    int next_free;    // Siguiente espacio libre (pila de reutilización)
+} AddrSpace;
+
+typedef struct {
+    int asid;         // Espacio de direcciones de la página cargada (-1 = libre)
+    int vpn;          // Página virtual cargada
+    int ref;          // Bit de referencia (CLOCK)
+    int prev, next;   // Orden de carga (FIFO) o de uso (LRU); 'next' encadena los libres
+} Frame;
+
+typedef struct {
+    unsigned int key; // (asid, vpn) + 1; 0 = entrada inválida
+    int frame;        // Marco traducido
+    unsigned int stamp; // Último uso (LRU dentro del conjunto)
+} TlbEntry;
+
+// ======================================================
+// 📌 Variables globales
+// ======================================================
+static AddrSpace *spaces = NULL;
+static int sp_len = 0, sp_cap = 0;
+static int sp_free = -1;             // Espacios libres para reutilizar
+static IntMap pid_space;             // PID → índice de espacio
+static int last_pid = -1, last_asid = -1; // Caché del último PID traducido
+
+static Frame *frames = NULL;
+static int nframes = 0;
+static int free_frame = -1;          // Marcos libres, encadenados por 'next'
+static int order_head = -1, order_tail = -1; // Cola FIFO / LRU de marcos ocupados
+static int hand = 0;                 // Manecilla de CLOCK
+static int pool_blk = -1;            // Bloque de la memoria con los marcos
+static long long frame_base = 0;     // Dirección física del marco 0
+
+static TlbEntry *tlb = NULL;
+static int tlb_sets = 0, tlb_ways = 0;
+static unsigned int tlb_clock = 0;
+
+static page_policy_t page_policy = PAGE_LRU;
+static PagingStats st;
+
+// ======================================================
+// 📌 Generador pseudoaleatorio (xorshift64*, como workload.c)
+// ======================================================
+static unsigned long long rng_state = 1;
+
+static void rng_seed(unsigned long long seed) {
+    unsigned long long z = seed + 0x9e3779b97f4a7c15ULL;
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    rng_state = (z ^ (z >> 31)) | 1;   // Nunca cero
+}
+
+static unsigned long long rng_next(void) {
+    rng_state ^= rng_state >> 12;
+    rng_state ^= rng_state << 25;
+    rng_state ^= rng_state >> 27;
+    return rng_state * 0x2545f4914f6cdd1dULL;
+}
+
+// ======================================================
+// 📌 TLB asociativa por conjuntos
+// ======================================================
+static unsigned int tlb_key(int asid, int vpn) {
+    return ((unsigned int)asid * PAGING_VPAGES + (unsigned int)vpn) + 1;
+}
+
+static TlbEntry *tlb_set(int asid, int vpn) {
+    unsigned int h = (unsigned int)vpn ^ ((unsigned int)asid * 0x9e3779b1u >> 16);
+    return &tlb[(h & (unsigned int)(tlb_sets - 1)) * tlb_ways];
+}
+
+// Reemplaza la entrada inválida o la menos usada del conjunto
+static void tlb_fill(TlbEntry *set, unsigned int key, int frame) {
+    int victim = 0;
+    for (int w = 0; w < tlb_ways; ++w) {
+        if (set[w].key == 0) { victim = w; break; }
+        if (set[w].stamp < set[victim].stamp) victim = w;
+    }
+    set[victim].key = key;
+    set[victim].frame = frame;
+    set[victim].stamp = ++tlb_clock;
+}
+
+static void tlb_invalidate(int asid, int vpn) {
+    TlbEntry *set = tlb_set(asid, vpn);
+    unsigned int key = tlb_key(asid, vpn);
+    for (int w = 0; w < tlb_ways; ++w)
+        if (set[w].key == key) set[w].key = 0;
+}
+
+// ======================================================
+// 📌 Cola de marcos ocupados (FIFO por carga, LRU por uso)
+// ======================================================
+static void order_append(int f) {
+    frames[f].prev = order_tail;
+    frames[f].next = -1;
+    if (order_tail != -1) frames[order_tail].next = f;
+    else order_head = f;
+    order_tail = f;
+}
+
+static void order_remove(int f) {
+    if (frames[f].prev != -1) frames[frames[f].prev].next = frames[f].next;
+    else order_head = frames[f].next;
+    if (frames[f].next != -1) frames[frames[f].next].prev = frames[f].prev;
+    else order_tail = frames[f].prev;
+}
+
+// ======================================================
+// 📌 Espacios de direcciones
+// ======================================================
+
+// Toma un espacio vacío para 'pid' (reutiliza uno libre o crece la
+// tabla). No lo registra en el índice. -1 sin memoria
+static int space_alloc(int pid) {
+    int a;
+    if (sp_free != -1) {
+        a = sp_free;
+        sp_free = spaces[a].next_free;
+    } else {
+        if (sp_len == sp_cap) {
+            int ncap = sp_cap ? sp_cap * 2 : 16;
+            AddrSpace *ns = realloc(spaces, (size_t)ncap * sizeof(AddrSpace));
+            if (!ns) return -1;
+            spaces = ns;
+            sp_cap = ncap;
+        }
+        a = sp_len++;
+        spaces[a].pte = malloc(PAGING_VPAGES * sizeof(int));
+        if (!spaces[a].pte) { sp_len--; return -1; }
+    }
+    for (int v = 0; v < PAGING_VPAGES; ++v) spaces[a].pte[v] = -1;
+    spaces[a].pid = pid;
+    spaces[a].resident = 0;
+    return a;
+}
+
+// Espacio del PID (lo crea en el primer acceso). -1 sin memoria
+static int space_of(int pid) {
+    if (pid == last_pid) return last_asid;
+    int a = intmap_get(&pid_space, pid);
+    if (a == -1) {
+        a = space_alloc(pid);
+        if (a == -1) return -1;
+        if (intmap_put(&pid_space, pid, a) == -1) {
+            spaces[a].pid = -1;
+            spaces[a].next_free = sp_free;
+            sp_free = a;
+            return -1;
+        }
+    }
+    last_pid = pid;
+    last_asid = a;
+    return a;
+}
+
+// Quita la página del marco 'f' de su tabla y de la TLB
+static void frame_unmap(int f) {
+    int a = frames[f].asid;
+    spaces[a].pte[frames[f].vpn] = -1;
+    spaces[a].resident--;
+    tlb_invalidate(a, frames[f].vpn);
+    order_remove(f);
+    frames[f].asid = -1;
+}
+
+// Devuelve los marcos del espacio 'a' y lo recicla: O(marcos)
+static void space_free(int a) {
+    for (int f = 0; f < nframes && spaces[a].resident > 0; ++f) {
+        if (frames[f].asid != a) continue;
+        frame_unmap(f);
+        frames[f].next = free_frame;
+        free_frame = f;
+    }
+    spaces[a].pid = -1;
+    spaces[a].next_free = sp_free;
+    sp_free = a;
+}
+
+// ======================================================
+// 📌 page_fault(asid, vpn)
+// Marco libre si queda alguno; si no, víctima según la política
+// ======================================================
+static int page_fault(int asid, int vpn) {
+    int f = free_frame;
+    if (f != -1) {
+        free_frame = frames[f].next;
+    } else {
+        if (page_policy == PAGE_CLOCK) {
+            // Segunda oportunidad: limpiar bits hasta hallar uno en 0
+            while (frames[hand].ref) {
+                frames[hand].ref = 0;
+                hand = (hand + 1) % nframes;
+            }
+            f = hand;
+            hand = (hand + 1) % nframes;
+        } else {
+            f = order_head;   // FIFO: cargada antes; LRU: usada antes
+        }
+        frame_unmap(f);
+        st.evictions++;
+    }
+    frames[f].asid = asid;
+    frames[f].vpn = vpn;
+    order_append(f);
+    spaces[asid].pte[vpn] = f;
+    spaces[asid].resident++;
+    return f;
+}
+
+// ======================================================
+// 📌 translate(asid, vaddr, paddr)
+// TLB → tabla de páginas → fallo de página
+// ======================================================
+static int translate(int asid, long long vaddr, long long *paddr) {
+    st.accesses++;
+    if (vaddr < 0 || vaddr >= (long long)PAGING_VPAGES * PAGE_SIZE) {
+        st.invalid++;
+        return XL_INVALID;
+    }
+    int vpn = (int)(vaddr / PAGE_SIZE);
+    unsigned int key = tlb_key(asid, vpn);
+    TlbEntry *set = tlb_set(asid, vpn);
+    int f = -1, res = XL_TLB;
+    for (int w = 0; w < tlb_ways; ++w) {
+        if (set[w].key == key) {
+            f = set[w].frame;
+            set[w].stamp = ++tlb_clock;
+            break;
+        }
+    }
+    if (f != -1) {
+        st.tlb_hits++;
+    } else {
+        f = spaces[asid].pte[vpn];
+        if (f == -1) {
+            f = page_fault(asid, vpn);
+            st.faults++;
+            res = XL_FAULT;
+        } else {
+            res = XL_TABLE;
+        }
+        tlb_fill(set, key, f);
+    }
+    frames[f].ref = 1;
+    if (page_policy == PAGE_LRU && f != order_tail) {
+        order_remove(f);
+        order_append(f);
+    }
+    *paddr = frame_base + (long long)f * PAGE_SIZE + vaddr % PAGE_SIZE;
+    return res;
+}
+
+// ======================================================
+// 📌 paging_init(frames, policy, sets, ways)
+// ======================================================
+int paging_init(int nf, page_policy_t policy, int sets, int ways) {
+    paging_shutdown();
+    if (nf <= 0) return -1;
+    if (sets <= 0) sets = PAGING_TLB_SETS;
+    if (ways <= 0) ways = PAGING_TLB_WAYS;
+    int s2 = 1;
+    while (s2 < sets) s2 *= 2;        // Conjuntos: potencia de 2
+
+    int blk = mem_alloc(MEM_OWNER_PAGING, (long long)nf * PAGE_SIZE);
+    if (blk == -1) return -1;
+    Frame *fr = malloc((size_t)nf * sizeof(Frame));
+    TlbEntry *tl = calloc((size_t)s2 * ways, sizeof(TlbEntry));
+    if (!fr || !tl) {
+        free(fr);
+        free(tl);
+        mem_free_block(blk);
+        return -1;
+    }
+
+    pool_blk = blk;
+    frames = fr;
+    nframes = nf;
+    free_frame = -1;
+    for (int f = nf - 1; f >= 0; --f) {
+        frames[f].asid = -1;
+        frames[f].ref = 0;
+        frames[f].next = free_frame;
+        free_frame = f;
+    }
+    order_head = order_tail = -1;
+    hand = 0;
+    tlb = tl;
+    tlb_sets = s2;
+    tlb_ways = ways;
+    tlb_clock = 0;
+    page_policy = policy;
+    intmap_init(&pid_space);
+    return 0;
+}
+
+void paging_shutdown(void) {
+    if (pool_blk == -1) return;
+    mem_free_block(pool_blk);
+    pool_blk = -1;
+    for (int a = 0; a < sp_len; ++a) free(spaces[a].pte);
+    free(spaces);
+    spaces = NULL;
+    sp_len = sp_cap = 0;
+    sp_free = -1;
+    intmap_free(&pid_space);
+    last_pid = last_asid = -1;
+    free(frames);
+    frames = NULL;
+    nframes = 0;
+    free(tlb);
+    tlb = NULL;
+}
+
+int paging_active(void) { return pool_blk != -1; }
+
+void paging_set_policy(page_policy_t policy) { page_policy = policy; }
+
+const char *paging_policy_name(page_policy_t policy) {
+    switch (policy) {
+    case PAGE_FIFO:  return "FIFO";
+    case PAGE_LRU:   return "LRU";
+    case PAGE_CLOCK: return "CLOCK";
+    }
+    return "?";
+}
+
+// ======================================================
+// 📌 paging_release(pid)
+// Devuelve los marcos del proceso y recicla su tabla: O(marcos)
+// ======================================================
+void paging_release(int pid) {
+    if (pool_blk == -1) return;
+    int a = intmap_get(&pid_space, pid);
+    if (a == -1) return;
+    space_free(a);
+    intmap_del(&pid_space, pid);
+    if (last_pid == pid) last_pid = last_asid = -1;
+}
+
+// ======================================================
+// 📌 Ejecución de cadenas de referencias
+// ======================================================
+static const char *XL_NAMES[] = { "TLB", "tabla", "FALLO", "invalida" };
+
+static void run_begin(struct timespec *t0) {
+    st.accesses = st.tlb_hits = st.faults = st.evictions = st.invalid = 0;
+    frame_base = mem_block_start(pool_blk);  // Puede haber cambiado al compactar
+    clock_gettime(CLOCK_MONOTONIC, t0);
+}
+
+static void run_report(const struct timespec *t0) {
+    struct timespec t1;
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    double secs = (double)(t1.tv_sec - t0->tv_sec) + (double)(t1.tv_nsec - t0->tv_nsec) / 1e9;
+    long long valid = st.accesses - st.invalid;
+    Mostrar("[INFO] Paginacion %s (%d marcos de %d bytes, TLB %dx%d): %lld acceso(s) en %.3f s (%.1f M accesos/s)\n",
+           paging_policy_name(page_policy), nframes, PAGE_SIZE, tlb_sets, tlb_ways,
+           st.accesses, secs, secs > 0 ? st.accesses / secs / 1e6 : 0.0);
+    Mostrar("[INFO] TLB: %lld acierto(s) (%.2f%%), fallos de pagina: %lld (%.2f%%), desalojos: %lld, invalidas: %lld\n",
+           st.tlb_hits, valid ? 100.0 * st.tlb_hits / valid : 0.0,
+           st.faults, valid ? 100.0 * st.faults / valid : 0.0,
+           st.evictions, st.invalid);
+}
+
+long long paging_run_file(const char *path) {
+    if (pool_blk == -1) return -1;
+    FILE *f = fopen(path, "r");
+    if (!f) return -1;
+
+    struct timespec t0;
+    run_begin(&t0);
+    int trace = proc_trace();
+    char line[256];
+    while (fgets(line, sizeof(line), f)) {
+        int pid;
+        long long vaddr, paddr = 0;
+        if (line[0] == '#' || sscanf(line, "%d %lld", &pid, &vaddr) != 2) continue;
+        int a = space_of(pid);
+        if (a == -1) break;
+        int res = translate(a, vaddr, &paddr);
+        if (trace) {
+            if (res == XL_INVALID) Mostrar("   PID=%d dir=%lld -> invalida\n", pid, vaddr);
+            else Mostrar("   PID=%d dir=%lld -> fisica=%lld (%s)\n", pid, vaddr, paddr, XL_NAMES[res]);
+        }
+    }
+    fclose(f);
+    run_report(&t0);
+    return st.accesses;
+}
+
+long long paging_run_synthetic(long long n, int procs, int pages, unsigned long long seed) {
+    if (pool_blk == -1 || n <= 0 || procs <= 0 || pages <= 0) return -1;
+    if (pages > PAGING_VPAGES) pages = PAGING_VPAGES;
+    int *base = calloc((size_t)procs, sizeof(int)); // Ventana caliente de cada proceso
+    int *asid = malloc((size_t)procs * sizeof(int)); // Espacio propio de cada proceso sintético
+    if (!base || !asid) { free(base); free(asid); return -1; }
+    for (int k = 0; k < procs; ++k) asid[k] = -1;
+
+    rng_seed(seed);
+    struct timespec t0;
+    run_begin(&t0);
+    int trace = proc_trace();
+    int cur = 0, a = -1;
+    for (long long i = 0; i < n; ++i) {
+        if (i % SYN_BURST == 0) {
+            // Cambio de contexto: otro proceso (la TLB no se vacía)
+            cur = (int)(rng_next() % (unsigned long long)procs);
+            if (asid[cur] == -1) asid[cur] = space_alloc(SYN_PID);
+            a = asid[cur];
+            if (a == -1) break;
+        }
+        if (i % SYN_SHIFT == 0) base[cur] = (int)(rng_next() % (unsigned long long)pages);
+
+        unsigned long long r = rng_next();
+        int vpn = (r % 10 < 9)
+            ? (int)((base[cur] + (r >> 8) % SYN_WINDOW) % pages)  // Localidad
+            : (int)((r >> 8) % (unsigned long long)pages);         // Acceso lejano
+        long long vaddr = (long long)vpn * PAGE_SIZE + (long long)((r >> 40) % PAGE_SIZE);
+        long long paddr;
+        int res = translate(a, vaddr, &paddr);
+        if (trace) Mostrar("   P%d dir=%lld -> fisica=%lld (%s)\n", cur + 1, vaddr, paddr, XL_NAMES[res]);
+    }
+    run_report(&t0);
+    // Los espacios sintéticos no sobreviven a la corrida: sus marcos y
+    // entradas de TLB no quedan para los procesos reales
+    for (int k = 0; k < procs; ++k)
+        if (asid[k] != -1) space_free(asid[k]);
+    free(base);
+    free(asid);
+    return st.accesses;
+}
+
+void paging_stats(PagingStats *out) { *out = st; }
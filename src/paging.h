@@ -0,0 +1,73 @@
+#ifndef PAGING_H
+#define PAGING_H
+
+// =====================================================
+// 📌 Memoria virtual paginada
+// =====================================================
+// Cada proceso (por PID) tiene su tabla de páginas y un espacio
+// lógico de PAGING_VPAGES páginas. Los marcos físicos salen de un
+// bloque de la memoria simulada (dueño MEM_OWNER_PAGING). La
+// traducción pasa primero por una TLB asociativa por conjuntos
+// etiquetada con el espacio de direcciones (no se vacía al cambiar
+// de proceso). Reemplazo de páginas: FIFO, LRU o CLOCK.
+
+// Tamaño de página / marco en bytes
+#define PAGE_SIZE 64
+
+// Páginas del espacio lógico de cada proceso (64 KB con páginas de 64 B)
+#define PAGING_VPAGES 1024
+
+// Geometría por defecto de la TLB
+#define PAGING_TLB_SETS 16
+#define PAGING_TLB_WAYS 4
+
+// Políticas de reemplazo
+typedef enum {
+    PAGE_FIFO = 0,    // La página cargada hace más tiempo
+    PAGE_LRU = 1,     // La usada hace más tiempo (lista con mover-al-final, O(1))
+    PAGE_CLOCK = 2    // Segunda oportunidad con bit de referencia
+} page_policy_t;
+
+// Contadores de una ejecución
+typedef struct {
+    long long accesses;   // Accesos traducidos
+    long long tlb_hits;   // Aciertos de TLB
+    long long faults;     // Fallos de página
+    long long evictions;  // Fallos que desalojaron otra página
+    long long invalid;    // Direcciones fuera del espacio lógico
+} PagingStats;
+
+// Crea el pool de 'frames' marcos (toma frames * PAGE_SIZE bytes de la
+// memoria simulada) y una TLB de tlb_sets x tlb_ways (<= 0 = por defecto).
+// Descarta tablas y marcos anteriores. Devuelve 0 o -1 sin memoria
+int paging_init(int frames, page_policy_t policy, int tlb_sets, int tlb_ways);
+
+// Devuelve los marcos a la memoria simulada y desactiva la paginación
+void paging_shutdown(void);
+
+// Indica si hay un pool de marcos activo
+int paging_active(void);
+
+// Cambia la política de reemplazo (vale para los próximos fallos)
+void paging_set_policy(page_policy_t policy);
+const char *paging_policy_name(page_policy_t policy);
+
+// Libera la tabla y los marcos de un proceso (al terminar)
+void paging_release(int pid);
+
+// Ejecuta una cadena de referencias desde un archivo: una referencia
+// por línea, "pid direccion" ('#' inicia un comentario).
+// Devuelve los accesos ejecutados o -1 si no se pudo abrir
+long long paging_run_file(const char *path);
+
+// Ejecuta 'n' referencias sintéticas con localidad (90% dentro de una
+// ventana de páginas calientes) repartidas entre 'procs' procesos de
+// 'pages' páginas cada uno. Reproducible con 'seed'. Los procesos
+// sintéticos tienen espacios propios (no son PID reales) que se
+// liberan con sus marcos al terminar
+long long paging_run_synthetic(long long n, int procs, int pages, unsigned long long seed);
+
+// Contadores de la última ejecución
+void paging_stats(PagingStats *st);
+
+#endif // PAGING_H
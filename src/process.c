@@ -1,51 +1,391 @@
 #include <stdio.h>      // Para printf (mensajes al usuario)
 #include <string.h>     // Para strncpy (copiar nombre del proceso)
-#include <unistd.h>     // Para sleep() (simulación de tiempo en scheduler)
+#include <stdlib.h>     // Para malloc/realloc (tabla y cola de listos dinámicas)
+#include <limits.h>     // Para LLONG_MAX (procesos sin plazo en EDF)
+#include <pthread.h>    // Hilos para la simulación SMP
+#include <sched.h>      // Para sched_yield (núcleos ociosos)
+#include <time.h>       // Para clock_gettime (tiempo de pared)
 #include "process.h"    // Cabecera con definición de Proc, MAX_PROCS, etc.
+#include "sim.h"        // Reloj de simulación y cola de eventos discretos
+#include "intmap.h"     // Índice hash PID → ranura
+#include "rbtree.h"     // Árbol rojo-negro (cola de CFS ordenada por vruntime)
+#include "metrics.h"    // Muestras de retorno/espera/respuesta y percentiles
+#include "memory.h"     // Memoria de los procesos que llegan desde una traza
+#include "paging.h"     // Tabla de páginas del proceso (se libera al terminar)
 #include "log.h"       // Módulo de logging
 
 // ======================================================
 // 📌 Variables globales
 // ======================================================
-static Proc procs[MAX_PROCS];  // Tabla de procesos (simulación de PCB)
-static int next_id = 0;        // Próximo ID de proceso a asignar
+// Tabla de procesos dividida en parte caliente y fría (misma ranura)
+static ProcHot *hot = NULL;    // remaining/alive contiguos para el planificador
+static Proc *procs = NULL;     // Datos descriptivos (PID, nombre, ráfaga...)
+static int table_cap = 0;      // Ranuras reservadas en ambos arreglos
+static int next_pid = 0;       // Próximo PID a asignar (independiente de la ranura)
+
+static int *free_slots = NULL; // Pila de ranuras libres para reutilizar
+static int free_len = 0;       // Ranuras libres en la pila
+static IntMap pid_slot;        // Índice PID → ranura
+
+// Cola de ejecución: FIFO circular de PIDs ejecutables.
+// Cada entrada recuerda también su ranura para despachar sin
+// consultar el índice; si la ranura ya cambió de dueño, se descarta.
+// La capacidad siempre es potencia de 2 para indexar con máscara.
+typedef struct { int slot; int pid; } RqEntry;
+typedef struct {
+    RqEntry *buf;              // Búfer circular
+    int cap;                   // Capacidad del búfer
+    int head;                  // Posición del primer PID en la cola
+    int len;                   // Entradas en la cola (puede incluir PIDs ya terminados)
+} RunQueue;
+
+static RunQueue readyq;        // Cola de listos global (orden de llegada)
+static int ready_count = 0;    // Procesos vivos con tiempo restante > 0
+
+// Política de planificación: operaciones sobre su propia cola.
+// El motor de eventos (sched_run) es común a todas las políticas.
+typedef struct {
+    const char *name;               // Nombre para los mensajes
+    void (*admit)(int slot);        // Recibe un proceso desde readyq (NULL = usa readyq)
+    int  (*pick)(void);             // Extrae la siguiente ranura a ejecutar o -1
+    int  (*slice)(int slot);        // Unidades máximas antes de reevaluar
+    void (*requeue)(int slot, int ran); // Reencola tras consumir 'ran' unidades
+    void (*on_dispatch)(void);      // Gancho opcional antes de cada elección
+    void (*on_exit)(int slot, int ran); // Gancho opcional al finalizar un proceso
+    void (*remove)(int slot);       // Saca una ranura terminada por proc_kill (NULL = perezoso)
+    int  (*preempt)(int slot);      // Tras cada unidad: != 0 si otro debe tomar la CPU
+} SchedPolicy;
+
+static const SchedPolicy *policy = NULL; // Política de la ejecución en curso
+
+// Traza detallada (una línea por unidad y por despacho). En ejecuciones
+// largas imprimir cuesta más que simular, por eso se puede silenciar
+static int sched_trace = 1;
+#define TRACE(...) do { if (sched_trace) Mostrar(__VA_ARGS__); } while (0)
+
+// Métricas de la ejecución en curso. Las muestras se reservan al
+// arrancar y al crear procesos, nunca dentro del bucle de eventos
+static MetricSet mt_turnaround;   // Retorno: finalización - llegada
+static MetricSet mt_waiting;      // Espera: retorno - ráfaga
+static MetricSet mt_response;     // Respuesta: primer despacho - llegada
+static long long mt_switches = 0; // Cambios de contexto
+static int mt_last_pid = -1;      // Último PID en CPU (motor secuencial)
+
+// Control externo (otro hilo): pausa y cancelación de la ejecución.
+// Se consultan una vez por evento, con lecturas atómicas baratas
+static int ctl_pause = 0;
+static int ctl_cancel = 0;
+
+// Llegadas futuras (trazas y cargas sintéticas). Se ordenan por
+// instante al arrancar el planificador y se consumen en orden
+typedef struct {
+    long long at;      // Instante relativo al inicio de la ejecución
+    long long seq;     // Orden de envío (desempata llegadas simultáneas)
+    char name[32];     // Nombre del proceso
+    int burst;         // Ráfaga de CPU
+    int mem;           // Bytes a reservar al llegar (0 = ninguno)
+} ProcArrival;
+
+static ProcArrival *arrivals = NULL;
+static int arr_len = 0;           // Llegadas registradas
+static int arr_cap = 0;           // Capacidad reservada
+static int arr_next = 0;          // Próxima llegada a crear
+static int arr_mem_fail = 0;      // Llegadas sin memoria disponible
 
 // ======================================================
-// 📌 proc_init()
-// Inicializa la tabla de procesos: marca todo como vacío
+// 📌 Funciones auxiliares de la tabla de procesos
 // ======================================================
-void proc_init() {
-    for (int i = 0; i < MAX_PROCS; ++i) {
-        procs[i].id = -1;          // Sin ID asignado
-        procs[i].alive = 0;        // Proceso no está activo
-        procs[i].mem_owner_id = -1;// Ningún bloque de memoria asignado
+
+// Duplica la capacidad de la tabla y apila las ranuras nuevas
+static int table_grow(void) {
+    if (table_cap >= PROC_TABLE_MAX) return -1;
+    int ncap = table_cap ? table_cap * 2 : MAX_PROCS;
+    if (ncap > PROC_TABLE_MAX) ncap = PROC_TABLE_MAX;
+
+    ProcHot *nh = realloc(hot, (size_t)ncap * sizeof(ProcHot));
+    if (!nh) return -1;
+    hot = nh;
+    Proc *np = realloc(procs, (size_t)ncap * sizeof(Proc));
+    if (!np) return -1;
+    procs = np;
+    int *nf = realloc(free_slots, (size_t)ncap * sizeof(int));
+    if (!nf) return -1;
+    free_slots = nf;
+
+    // Apilar en orden inverso: las ranuras bajas se usan primero
+    for (int i = ncap - 1; i >= table_cap; --i) {
+        hot[i].remaining = 0;
+        hot[i].alive = 0;
+        procs[i].id = -1;
+        free_slots[free_len++] = i;
     }
-    next_id = 0;                   // Reiniciar contador de procesos
+    table_cap = ncap;
+    return 0;
+}
+
+// Devuelve la ranura del PID o -1 si no existe: O(1)
+static int slot_of(int pid) {
+    return intmap_get(&pid_slot, pid);
+}
+
+// Libera la ranura de un proceso terminado para reutilizarla
+static void slot_release(int slot) {
+    mem_free_by_owner(procs[slot].id); // Sus bloques: O(bloques que posee)
+    paging_release(procs[slot].id);  // Sus marcos vuelven al pool
+    intmap_del(&pid_slot, procs[slot].id);
+    procs[slot].id = -1;
+    hot[slot].alive = 0;
+    hot[slot].remaining = 0;
+    free_slots[free_len++] = slot;
 }
 
 // ======================================================
-// 📌 proc_create(name, burst)
-// Crea un nuevo proceso con nombre y burst time dado.
-// Devuelve el ID del proceso o -1 si no hay espacio.
+// 📌 Funciones auxiliares de las colas de ejecución
 // ======================================================
-int proc_create(const char *name, int burst) {
-    if (next_id >= MAX_PROCS) {
-        Mostrar("[WARNING] Limite de procesos alcanzado (%d)\n", MAX_PROCS);
+
+// Indica si la entrada sigue refiriéndose a un proceso ejecutable
+static int is_ready(int slot, int pid) {
+    return procs[slot].id == pid && hot[slot].alive && hot[slot].remaining > 0;
+}
+
+// Quita las entradas de procesos terminados conservando el orden: O(len)
+static void rq_compact(RunQueue *q) {
+    int n = 0;
+    for (int k = 0; k < q->len; ++k) {
+        RqEntry e = q->buf[(q->head + k) & (q->cap - 1)];
+        if (is_ready(e.slot, e.pid)) q->buf[(q->head + n++) & (q->cap - 1)] = e;
+    }
+    q->len = n;
+}
+
+// Encola una ranura al final: O(1) amortizado. Con el búfer lleno
+// primero descarta las entradas muertas y solo lo duplica si siguen
+// ocupando más de la mitad (así la cola no crece sin límite con
+// ciclos de crear/terminar sin ejecutar el planificador)
+static int rq_push(RunQueue *q, int slot) {
+    if (q->len == q->cap) {
+        rq_compact(q);   // Primero descartar las entradas muertas
+        if (q->len * 2 >= q->cap) {
+            int ncap = q->cap ? q->cap * 2 : MAX_PROCS;
+            RqEntry *nb = malloc((size_t)ncap * sizeof(RqEntry));
+            if (!nb && q->len == q->cap) return -1;
+            if (nb) {
+                // Copiar en orden, desenrollando el círculo
+                for (int k = 0; k < q->len; ++k)
+                    nb[k] = q->buf[(q->head + k) & (q->cap - 1)];
+                free(q->buf);
+                q->buf = nb;
+                q->cap = ncap;
+                q->head = 0;
+            }
+        }
+    }
+    RqEntry *e = &q->buf[(q->head + q->len) & (q->cap - 1)];
+    e->slot = slot;
+    e->pid = procs[slot].id;
+    q->len++;
+    return 0;
+}
+
+// Desencola la primera ranura ejecutable: O(1) amortizado.
+// Las entradas de procesos terminados (proc_kill) se descartan aquí.
+static int rq_pop(RunQueue *q) {
+    while (q->len > 0) {
+        RqEntry e = q->buf[q->head];
+        q->head = (q->head + 1) & (q->cap - 1);
+        q->len--;
+        if (is_ready(e.slot, e.pid)) return e.slot;
+    }
+    return -1;
+}
+
+// ======================================================
+// 📌 Funciones auxiliares de métricas
+// ======================================================
+
+// Asegura espacio para una muestra por cada proceso aún pendiente
+// más 'extra' que todavía no llegaron
+static int metrics_reserve(int extra) {
+    int n = mt_turnaround.len + ready_count + extra;
+    if (metric_reserve(&mt_turnaround, n) == -1 ||
+        metric_reserve(&mt_waiting, n) == -1 ||
+        metric_reserve(&mt_response, n) == -1) return -1;
+    return 0;
+}
+
+// Reinicia los contadores al comenzar una ejecución
+static void metrics_begin(void) {
+    metric_reset(&mt_turnaround);
+    metric_reset(&mt_waiting);
+    metric_reset(&mt_response);
+    mt_switches = 0;
+    mt_last_pid = -1;
+    if (metrics_reserve(0) == -1)
+        Mostrar("[WARNING] Sin memoria para las metricas: algunas muestras se omitiran\n");
+}
+
+// Anota un despacho: primer uso de CPU y cambio de contexto: O(1).
+// Devuelve 1 si la CPU cambió de proceso
+static int metrics_dispatch(int slot, long long now, int *last_pid) {
+    if (procs[slot].first_run < 0) procs[slot].first_run = now;
+    if (procs[slot].id == *last_pid) return 0; // Sigue el mismo proceso
+    procs[slot].switches++;
+    *last_pid = procs[slot].id;
+    return 1;
+}
+
+// Registra las muestras de un proceso que acaba de terminar: O(1)
+static void metrics_record(int slot, long long now) {
+    long long tat = now - procs[slot].arrival;
+    procs[slot].completion = now;
+    metric_add(&mt_turnaround, tat);
+    metric_add(&mt_waiting, tat - procs[slot].burst);
+    metric_add(&mt_response, procs[slot].first_run - procs[slot].arrival);
+}
+
+static void metrics_row(const char *name, MetricSet *m) {
+    MetricSummary s;
+    metric_summary(m, &s);
+    Mostrar("%s\t%.2f\t%lld\t%lld\t%lld\t%lld\n", name, s.mean, s.p50, s.p95, s.p99, s.max);
+}
+
+// ======================================================
+// 📌 metrics_report(elapsed)
+// Resumen de la ejecución: throughput, cambios de contexto
+// y media/p50/p95/p99/máximo de retorno, espera y respuesta
+// ======================================================
+static void metrics_report(long long elapsed) {
+    int done = mt_turnaround.len;
+    if (done == 0 && mt_turnaround.dropped == 0) return;
+    Mostrar("[INFO] Metricas: %d completado(s) en %lld unidades, throughput=%.3f procesos/unidad, cambios de contexto=%lld\n",
+           done, elapsed, elapsed > 0 ? (double)done / elapsed : 0.0, mt_switches);
+    if (mt_turnaround.dropped > 0)
+        Mostrar("[WARNING] %lld muestra(s) omitidas por falta de memoria\n", mt_turnaround.dropped);
+    Mostrar("Metrica\t\tMedia\tP50\tP95\tP99\tMax\n");
+    metrics_row("Retorno\t", &mt_turnaround);
+    metrics_row("Espera\t", &mt_waiting);
+    metrics_row("Respuesta", &mt_response);
+}
+
+// ======================================================
+// 📌 proc_set_trace(on) / proc_trace()
+// Activa o silencia la traza detallada de los planificadores
+// ======================================================
+void proc_set_trace(int on) { sched_trace = on ? 1 : 0; }
+int proc_trace(void) { return sched_trace; }
+
+// ======================================================
+// 📌 proc_sched_pause(on) / proc_sched_cancel() / proc_sched_reset()
+// Seguras desde cualquier hilo: solo escriben banderas atómicas.
+// Las banderas se limpian antes de lanzar cada comando (no al
+// arrancar el planificador): así un Cancelar pulsado justo
+// después de lanzarlo no se pierde
+// ======================================================
+void proc_sched_pause(int on) { __atomic_store_n(&ctl_pause, on ? 1 : 0, __ATOMIC_RELEASE); }
+int proc_sched_paused(void) { return __atomic_load_n(&ctl_pause, __ATOMIC_ACQUIRE); }
+void proc_sched_cancel(void) { __atomic_store_n(&ctl_cancel, 1, __ATOMIC_RELEASE); }
+
+void proc_sched_reset(void) {
+    __atomic_store_n(&ctl_pause, 0, __ATOMIC_RELEASE);
+    __atomic_store_n(&ctl_cancel, 0, __ATOMIC_RELEASE);
+}
+
+// Espera mientras haya pausa. Devuelve 1 si se pidió cancelar
+static int sched_control_wait(void) {
+    while (__atomic_load_n(&ctl_pause, __ATOMIC_ACQUIRE) &&
+           !__atomic_load_n(&ctl_cancel, __ATOMIC_ACQUIRE))
+        sim_sleep_ms(10);
+    return __atomic_load_n(&ctl_cancel, __ATOMIC_ACQUIRE);
+}
+
+// Tras cancelar: los procesos que quedaron en colas de la política
+// vuelven a readyq (en orden de ranura) para la próxima ejecución
+static int sched_requeue_all(void) {
+    int n = 0;
+    readyq.head = readyq.len = 0;
+    for (int i = 0; i < table_cap; ++i) {
+        if (procs[i].id != -1 && hot[i].alive && hot[i].remaining > 0) {
+            rq_push(&readyq, i);
+            n++;
+        }
+    }
+    return n;
+}
+
+// ======================================================
+// 📌 proc_init()
+// Inicializa la tabla de procesos: marca todo como vacío
+// ======================================================
+void proc_init() {
+    free(hot); free(procs); free(free_slots);
+    hot = NULL; procs = NULL; free_slots = NULL;
+    table_cap = free_len = 0;
+    intmap_free(&pid_slot);
+
+    table_grow();                  // Capacidad inicial: MAX_PROCS ranuras
+    next_pid = 0;                  // Reiniciar contador de procesos
+    readyq.head = readyq.len = 0;  // Cola de listos vacía
+    ready_count = 0;
+}
+
+// Crea el proceso sin anunciarlo (lo usan proc_create y las llegadas).
+// Toma una ranura libre (O(1)) o hace crecer la tabla
+static int proc_spawn(const char *name, int burst) {
+    if (free_len == 0 && table_grow() == -1) {
+        Mostrar("[WARNING] Limite de procesos alcanzado (%d)\n", table_cap);
         return -1; // No hay espacio
     }
 
-    int idx = next_id++;   // Asignar nuevo índice
-    procs[idx].id = idx;   // ID del proceso
+    int idx = free_slots[--free_len]; // Ranura libre reutilizada
+    int pid = next_pid;
+    if (intmap_put(&pid_slot, pid, idx) == -1) {
+        free_slots[free_len++] = idx;
+        Mostrar("[ERROR] Sin memoria para el indice de procesos\n");
+        return -1;
+    }
+    next_pid++;
+
+    procs[idx].id = pid;   // ID del proceso
     strncpy(procs[idx].name, name, sizeof(procs[idx].name)-1); // Guardar nombre
+    procs[idx].name[sizeof(procs[idx].name)-1] = '\0';
     procs[idx].burst = burst;       // Tiempo total requerido
-    procs[idx].remaining = burst;   // Tiempo restante = burst inicial
-    procs[idx].alive = 1;           // Activo
-    procs[idx].mem_owner_id = -1;   // Aún sin memoria asignada
+    procs[idx].level = 0;           // MLFQ: entra con máxima prioridad
+    procs[idx].nice = 0;            // CFS: prioridad por defecto
+    procs[idx].weight = CFS_NICE0_WEIGHT;
+    procs[idx].vruntime = 0;
+    procs[idx].deadline = -1;       // Sin plazo (EDF lo trata como infinito)
+    procs[idx].last_core = -1;      // SMP: aún no ha ejecutado en ningún núcleo
+    procs[idx].ready_at = 0;
+    procs[idx].arrival = sim_now(); // Métricas: llega al crearse
+    procs[idx].first_run = -1;
+    procs[idx].completion = -1;
+    procs[idx].switches = 0;
+    hot[idx].remaining = burst;     // Tiempo restante = burst inicial
+    hot[idx].alive = 1;             // Activo
 
-    Mostrar("[OK] Proceso creado: ID=%d, name=%s, burst=%d\n",
-           idx, procs[idx].name, burst);
+    // Un proceso con ráfaga > 0 entra directamente a la cola de listos
+    if (burst > 0) {
+        if (rq_push(&readyq, idx) == -1) {
+            slot_release(idx);
+            Mostrar("[ERROR] Sin memoria para la cola de listos\n");
+            return -1;
+        }
+        ready_count++;
+        if (policy) metrics_reserve(0); // Llegó durante una ejecución
+    }
+    return pid;
+}
 
-    return idx;
+// ======================================================
+// 📌 proc_create(name, burst)
+// Crea un nuevo proceso con nombre y burst time dado.
+// Devuelve el PID del proceso o -1 si no hay espacio.
+// ======================================================
+int proc_create(const char *name, int burst) {
+    int pid = proc_spawn(name, burst);
+    if (pid != -1)
+        Mostrar("[OK] Proceso creado: ID=%d, name=%s, burst=%d\n", pid, name, burst);
+    return pid;
 }
 
 // ======================================================
@@ -53,91 +393,1178 @@ int proc_create(const char *name, int burst) {
 // Lista todos los procesos con sus atributos principales
 // ======================================================
 void proc_list() {
-    Mostrar("ID\tName\tBurst\tRemaining\tAlive\tMemOwner\n");
-    for (int i = 0; i < next_id; ++i) {
+    Mostrar("ID\tName\tBurst\tRemaining\tAlive\tMemBlocks\tMemBytes\tNice\tDeadline\n");
+    for (int i = 0; i < table_cap; ++i) {
         if (procs[i].id != -1) {
-            Mostrar("%d\t%s\t%d\t%d\t\t%d\t%d\n",
+            MemOwnerUsage mu;
+            mem_owner_usage(procs[i].id, &mu); // Índice por dueño: O(1)
+            Mostrar("%d\t%s\t%d\t%d\t\t%d\t%d\t\t%lld\t\t%d\t%lld\n",
                 procs[i].id,
                 procs[i].name,
                 procs[i].burst,
-                procs[i].remaining,
-                procs[i].alive,
-                procs[i].mem_owner_id);
+                hot[i].remaining,
+                hot[i].alive,
+                mu.blocks,
+                mu.bytes,
+                procs[i].nice,
+                procs[i].deadline);
         }
     }
 }
 
 // ======================================================
 // 📌 proc_count()
-// Cuenta procesos vivos con tiempo restante > 0
+// Cuenta procesos vivos con tiempo restante > 0.
+// El contador se mantiene al crear/terminar: O(1)
 // ======================================================
 int proc_count() {
-    int c = 0;
-    for (int i = 0; i < next_id; ++i) {
-        if (procs[i].alive && procs[i].remaining > 0) c++;
-    }
-    return c;
+    return ready_count;
 }
 
 // ======================================================
 // 📌 proc_kill(id)
-// Termina un proceso específico por su ID.
+// Termina un proceso específico por su ID y libera su ranura.
+// Su entrada en la cola de listos se descarta al desencolar
+// o cuando la cola se compacta al llenarse.
 // Devuelve 0 si se eliminó, -1 si no existe.
 // ======================================================
 int proc_kill(int id) {
-    if (id < 0 || id >= next_id || procs[id].id == -1) return -1;
+    int slot = slot_of(id);
+    if (slot == -1) return -1;
 
-    procs[id].alive = 0;      // Marcamos como muerto
-    procs[id].remaining = 0;  // Ya no tiene CPU por ejecutar
+    if (is_ready(slot, id)) ready_count--; // Deja de contar como listo
+    if (policy && policy->remove) policy->remove(slot); // Sacarlo de la cola de la política
+    slot_release(slot);       // Libera su memoria, lo marca como muerto y recicla la ranura
     Mostrar("[INFO] Proceso ID=%d terminado por peticion\n", id);
 
     return 0;
 }
 
+// ======================================================
+// 📌 proc_submit(at, name, burst, mem)
+// Registra una llegada futura para la próxima ejecución
+// del planificador: O(1) amortizado
+// ======================================================
+int proc_submit(long long at, const char *name, int burst, int mem) {
+    if (arr_len == arr_cap) {
+        int ncap = arr_cap ? arr_cap * 2 : 256;
+        ProcArrival *na = realloc(arrivals, (size_t)ncap * sizeof(ProcArrival));
+        if (!na) return -1;
+        arrivals = na;
+        arr_cap = ncap;
+    }
+    ProcArrival *a = &arrivals[arr_len];
+    a->at = at > 0 ? at : 0;
+    a->seq = arr_len;
+    strncpy(a->name, name, sizeof(a->name) - 1);
+    a->name[sizeof(a->name) - 1] = '\0';
+    a->burst = burst;
+    a->mem = mem > 0 ? mem : 0;
+    arr_len++;
+    return 0;
+}
+
+int proc_pending_arrivals(void) { return arr_len - arr_next; }
+
+void proc_clear_arrivals(void) { arr_len = arr_next = 0; }
+
+static int arrival_cmp(const void *a, const void *b) {
+    const ProcArrival *x = a, *y = b;
+    if (x->at != y->at) return x->at < y->at ? -1 : 1;
+    return (x->seq > y->seq) - (x->seq < y->seq);
+}
+
+// ======================================================
+// 📌 sched_arrive(t0)
+// Crea los procesos cuya llegada ya ocurrió (reservando su
+// memoria) y programa un único EV_ARRIVAL para la siguiente
+// ======================================================
+static void sched_arrive(long long t0) {
+    while (arr_next < arr_len && t0 + arrivals[arr_next].at <= sim_now()) {
+        ProcArrival *a = &arrivals[arr_next++];
+        int pid = proc_spawn(a->name, a->burst);
+        if (pid == -1) continue;
+        int slot = slot_of(pid);
+        TRACE("[INFO] t=%lld llega PID=%d (%s, rafaga=%d, memoria=%d)\n",
+              sim_now(), pid, a->name, a->burst, a->mem);
+        if (a->mem > 0 && mem_alloc(pid, a->mem) == -1) {
+            arr_mem_fail++;
+            TRACE("   [WARNING] PID=%d sin memoria para %d bytes\n", pid, a->mem);
+        }
+        if (a->burst <= 0) {
+            // Nada que ejecutar: termina al llegar
+            slot_release(slot);
+        }
+    }
+    if (arr_next < arr_len)
+        sim_schedule(t0 + arrivals[arr_next].at - sim_now(), EV_ARRIVAL, arr_next);
+}
+
+// ======================================================
+// 📌 sched_dispatch(exec)
+// Pasa los procesos recién admitidos a la política activa,
+// elige el siguiente y programa su primer tick.
+// Devuelve la ranura elegida (o -1) y en *exec sus unidades.
+// ======================================================
+// Las políticas con cola propia absorben lo que llegó a readyq
+static void sched_absorb(void) {
+    if (!policy->admit) return;
+    int slot;
+    while ((slot = rq_pop(&readyq)) != -1) policy->admit(slot);
+}
+
+// Programa el próximo tick y devuelve cuántas unidades cubre:
+// con traza (o si la política puede expropiar) una por evento;
+// en modo silencioso, el resto de la porción en un solo evento
+static int sched_tick(int slot, int left) {
+    int step = (sched_trace || policy->preempt) ? 1 : left;
+    sim_schedule(step, EV_TICK, slot);
+    return step;
+}
+
+static int sched_dispatch(int *exec, int *step) {
+    if (policy->on_dispatch) policy->on_dispatch();
+    sched_absorb();
+
+    int i = policy->pick();
+    if (i == -1) return -1;
+
+    // Determinar cuánto ejecuta este proceso
+    int q = policy->slice(i);
+    if (q <= 0) q = 1;
+    *exec = (hot[i].remaining > q) ? q : hot[i].remaining;
+    mt_switches += metrics_dispatch(i, sim_now(), &mt_last_pid);
+
+    TRACE("[OK] Ejecutando PID=%d (%s) por %d unidad(es). Restante: %d\n",
+           procs[i].id, procs[i].name, *exec, hot[i].remaining);
+
+    *step = sched_tick(i, *exec); // Primera unidad (o porción) de CPU
+    return i;
+}
+
+// ======================================================
+// 📌 sched_run(pol)
+// Motor común de planificación guiado por eventos discretos:
+// cada unidad de CPU es un EV_TICK. El reloj (sim.c) decide
+// si el tiempo avanza al instante (modo VIRTUAL) o a ritmo
+// de pared (modo REAL). La política solo decide el orden.
+// ======================================================
+static void sched_run(const SchedPolicy *pol) {
+    policy = pol;
+    long long t0 = sim_now();
+    int exec = 0, ran = 0, step = 1, cancelled = 0;
+    sim_clear();
+    metrics_begin();
+
+    // Llegadas pendientes: se reproducen sobre el tiempo virtual
+    int replay_first = arr_next, replay = arr_next < arr_len;
+    if (replay) {
+        qsort(arrivals + arr_next, (size_t)(arr_len - arr_next), sizeof(ProcArrival), arrival_cmp);
+        arr_mem_fail = 0;
+        mem_reset_stats();
+        metrics_reserve(arr_len - arr_next); // Muestras para todas las llegadas
+        sched_arrive(t0);
+    }
+
+    // Poner en CPU al primer proceso listo (si existe)
+    int cur = sched_dispatch(&exec, &step);
+
+    SimEvent ev;
+    while (sim_next(&ev)) {
+        if (sched_control_wait()) { cancelled = 1; break; }
+        if (ev.kind == EV_ARRIVAL) {
+            sched_arrive(t0);
+            if (cur == -1) cur = sched_dispatch(&exec, &step); // CPU ociosa
+            continue;
+        }
+        if (ev.kind != EV_TICK) continue;
+
+        // Unidad(es) de CPU consumidas por el proceso en ejecución
+        hot[cur].remaining -= step;
+        ran += step;
+        TRACE("   [OK] PID=%d: ejecutado 1 unidad, resta %d\n",
+               procs[cur].id, hot[cur].remaining);
+
+        // ¿Expropiación? (p.ej. llegó alguien con menos ráfaga o plazo)
+        int preempted = 0;
+        if (hot[cur].remaining > 0 && policy->preempt) {
+            sched_absorb();
+            preempted = policy->preempt(cur);
+        }
+
+        // ¿Sigue dentro de su quantum?
+        if (hot[cur].remaining > 0 && ran < exec && !preempted) {
+            step = sched_tick(cur, exec - ran);
+            continue;
+        }
+
+        if (hot[cur].remaining <= 0) {
+            // Terminó durante este quantum → finalizado y ranura reciclada
+            ready_count--;
+            metrics_record(cur, sim_now());
+            TRACE("[INFO] PID=%d (%s) finalizado\n", procs[cur].id, procs[cur].name);
+            if (policy->on_exit) policy->on_exit(cur, ran);
+            slot_release(cur);
+        } else {
+            // Expiró el quantum o fue expropiado → la política decide dónde vuelve
+            if (preempted) TRACE("[INFO] PID=%d expropiado en t=%lld\n", procs[cur].id, sim_now());
+            policy->requeue(cur, ran);
+        }
+
+        // Cambio de contexto: siguiente proceso elegido por la política
+        ran = 0;
+        cur = sched_dispatch(&exec, &step);
+    }
+
+    if (cancelled) {
+        sim_clear();
+        int back = sched_requeue_all();
+        Mostrar("[WARNING] Scheduler %s cancelado en t=%lld: %d proceso(s) vuelven a la cola de listos\n",
+               pol->name, sim_now(), back);
+    }
+    metrics_report(sim_now() - t0);
+    if (replay) {
+        Mostrar("[INFO] Llegadas reproducidas: %d, sin memoria al llegar: %d\n",
+               arr_next - replay_first, arr_mem_fail);
+        MemStats ms;
+        mem_stats(&ms);
+        Mostrar("[INFO] Memoria (%s): pico ocupado %lld bytes, pico de fragmentacion interna %lld bytes, "
+               "fallos %d (%d con memoria libre total suficiente)\n",
+               mem_get_mode() == MEM_MODE_BUDDY ? "buddy" : mem_policy_name(mem_get_policy()),
+               ms.peak_alloc, ms.peak_waste, ms.fails, ms.frag_fails);
+        if (ms.compactions > 0)
+            Mostrar("[INFO] Compactaciones: %d (%lld bytes movidos, %lld ns)\n",
+                   ms.compactions, ms.moved_bytes, ms.compact_ns);
+        proc_clear_arrivals();
+    }
+    if (!cancelled)
+        Mostrar("[INFO] Scheduler %s finalizado en t=%lld (%lld unidades simuladas). No quedan procesos listos.\n\n",
+               pol->name, sim_now(), sim_now() - t0);
+    policy = NULL;
+}
+
+// ======================================================
+// 📌 Política Round-Robin
+// Usa directamente la cola de listos global: O(1) por despacho
+// ======================================================
+static int rr_quantum = 1;
+
+static int rr_pick(void) { return rq_pop(&readyq); }
+static int rr_slice(int slot) { (void)slot; return rr_quantum; }
+static void rr_requeue(int slot, int ran) { (void)ran; rq_push(&readyq, slot); }
+
+static const SchedPolicy RR_POLICY = {
+    .name = "Round-Robin",
+    .pick = rr_pick,
+    .slice = rr_slice,
+    .requeue = rr_requeue,
+};
+
 // ======================================================
 // 📌 proc_scheduler_rr(quantum)
 // Implementa un scheduler Round-Robin simplificado.
-// Cada unidad de tiempo = 1 segundo (sleep).
+// Despacho y reencolado son O(1) sobre la cola de listos.
 // ======================================================
 void proc_scheduler_rr(int quantum) {
     if (quantum <= 0) quantum = 1; // Quantum mínimo = 1
 
-    Mostrar("\n[INFO] Iniciando scheduler Round-Robin (quantum=%d unidades)\n", quantum);
+    Mostrar("\n[INFO] Iniciando scheduler Round-Robin (quantum=%d unidades, reloj %s)\n",
+           quantum, sim_clock_mode() == SIM_CLOCK_VIRTUAL ? "virtual" : "real");
 
-    int remaining_procs = proc_count();
+    rr_quantum = quantum;
+    sched_run(&RR_POLICY);
+}
 
-    // Mientras existan procesos listos
-    while (remaining_procs > 0) {
-        for (int i = 0; i < next_id; ++i) {
-            // Saltar si no está activo
-            if (!procs[i].alive || procs[i].remaining <= 0) continue;
+// ======================================================
+// 📌 Política MLFQ (Multilevel Feedback Queue)
+// Un FIFO por nivel y un bitmap con un bit por nivel no vacío:
+// el nivel más prioritario se obtiene con find-first-set, O(1).
+//  - Los procesos nuevos entran al nivel 0 (máxima prioridad)
+//  - Si agotan su quantum bajan un nivel
+//  - Cada 'boost' unidades todos vuelven al nivel 0
+// ======================================================
+static RunQueue mlfq_q[MLFQ_MAX_LEVELS]; // Cola FIFO por nivel
+static unsigned int mlfq_bitmap = 0;     // Bit l = 1 si mlfq_q[l] no está vacía
+static int mlfq_levels = MLFQ_DEFAULT_LEVELS;
+static int mlfq_quantum[MLFQ_MAX_LEVELS];
+static int mlfq_boost = 0;               // Periodo de boost (0 = desactivado)
+static long long mlfq_next_boost = 0;    // Próximo instante de boost
 
-            // Determinar cuánto ejecuta este proceso
-            int exec = (procs[i].remaining > quantum) ? quantum : procs[i].remaining;
+// Coloca la ranura al final del nivel indicado y marca el bitmap
+static void mlfq_enqueue(int slot, int level) {
+    procs[slot].level = level;
+    rq_push(&mlfq_q[level], slot);
+    mlfq_bitmap |= 1u << level;
+}
 
-            Mostrar("[OK] Ejecutando PID=%d (%s) por %d unidad(es). Restante: %d\n",
-                   procs[i].id, procs[i].name, exec, procs[i].remaining);
+static void mlfq_admit(int slot) { mlfq_enqueue(slot, 0); }
 
-            // Simular ejecución en intervalos de 1 segundo
-            for (int t = 0; t < exec; ++t) {
-                sleep(1); // Simula uso de CPU
-                procs[i].remaining -= 1; // Reducir tiempo restante
-                Mostrar("   [OK] PID=%d: ejecutado 1 unidad, resta %d\n",
-                       procs[i].id, procs[i].remaining);
+static int mlfq_pick(void) {
+    while (mlfq_bitmap) {
+        int l = __builtin_ctz(mlfq_bitmap);  // Nivel no vacío más prioritario
+        int slot = rq_pop(&mlfq_q[l]);
+        if (mlfq_q[l].len == 0) mlfq_bitmap &= ~(1u << l);
+        if (slot != -1) return slot;         // Entradas muertas se saltan
+    }
+    return -1;
+}
 
-                if (procs[i].remaining <= 0) break; // Terminó el proceso
-            }
+static int mlfq_slice(int slot) { return mlfq_quantum[procs[slot].level]; }
+
+static void mlfq_requeue(int slot, int ran) {
+    int l = procs[slot].level;
+    // Agotó el quantum completo → pierde prioridad
+    if (ran >= mlfq_quantum[l] && l + 1 < mlfq_levels) l++;
+    mlfq_enqueue(slot, l);
+}
+
+// Boost periódico: sube todos los niveles inferiores al nivel 0
+static void mlfq_on_dispatch(void) {
+    if (mlfq_boost <= 0 || sim_now() < mlfq_next_boost) return;
+    mlfq_next_boost = sim_now() + mlfq_boost;
+
+    int moved = 0, slot;
+    for (int l = 1; l < mlfq_levels; ++l) {
+        while ((slot = rq_pop(&mlfq_q[l])) != -1) {
+            mlfq_enqueue(slot, 0);
+            moved++;
+        }
+        mlfq_bitmap &= ~(1u << l);
+    }
+    if (moved > 0)
+        TRACE("[INFO] Boost de prioridad en t=%lld: %d proceso(s) al nivel 0\n",
+               sim_now(), moved);
+}
+
+static const SchedPolicy MLFQ_POLICY = {
+    .name = "MLFQ",
+    .admit = mlfq_admit,
+    .pick = mlfq_pick,
+    .slice = mlfq_slice,
+    .requeue = mlfq_requeue,
+    .on_dispatch = mlfq_on_dispatch,
+};
+
+// ======================================================
+// 📌 proc_scheduler_mlfq(levels, quanta, boost)
+// Configura niveles, quantum por nivel y periodo de boost,
+// y ejecuta el motor común con la política MLFQ.
+// Si 'quanta' es NULL, el nivel l usa quantum 2^l.
+// ======================================================
+void proc_scheduler_mlfq(int levels, const int *quanta, int nquanta, int boost) {
+    if (levels <= 0) levels = MLFQ_DEFAULT_LEVELS;
+    if (levels > MLFQ_MAX_LEVELS) levels = MLFQ_MAX_LEVELS;
+
+    mlfq_levels = levels;
+    for (int l = 0; l < levels; ++l) {
+        int q;
+        if (quanta && nquanta > 0)
+            // Si faltan valores, cada nivel extra duplica el último indicado
+            q = (l < nquanta) ? quanta[l] : mlfq_quantum[l - 1] * 2;
+        else
+            q = 1 << (l < 20 ? l : 20);
+        mlfq_quantum[l] = q > 0 ? q : 1;
+        mlfq_q[l].head = mlfq_q[l].len = 0;
+    }
+    mlfq_bitmap = 0;
+    mlfq_boost = boost > 0 ? boost : 0;
+    mlfq_next_boost = sim_now() + mlfq_boost;
+
+    // Describir la configuración en una sola línea (p.ej. "2/4/8")
+    char qdesc[256];
+    int off = 0;
+    for (int l = 0; l < levels && off < (int)sizeof(qdesc) - 12; ++l)
+        off += snprintf(qdesc + off, sizeof(qdesc) - off, "%s%d", l ? "/" : "", mlfq_quantum[l]);
+
+    Mostrar("\n[INFO] Iniciando scheduler MLFQ (%d niveles, quantum=%s, boost=%d, reloj %s)\n",
+           levels, qdesc, mlfq_boost,
+           sim_clock_mode() == SIM_CLOCK_VIRTUAL ? "virtual" : "real");
+
+    sched_run(&MLFQ_POLICY);
+}
+
+// ======================================================
+// 📌 Política CFS (Completely Fair Scheduler)
+// Los procesos ejecutables viven en un árbol rojo-negro
+// ordenado por vruntime; el siguiente es el de menor vruntime
+// (mínimo en caché + borrado O(log N)). El vruntime avanza
+// más despacio cuanto mayor es el peso (nice más bajo).
+// ======================================================
+
+// Pesos por nice (-20..19), misma tabla que el kernel Linux:
+// cada nivel de nice equivale a ~10% de CPU
+static const int nice_to_weight[40] = {
+    88761, 71755, 56483, 46273, 36291,
+    29154, 23254, 18705, 14949, 11916,
+     9548,  7620,  6100,  4904,  3906,
+     3121,  2501,  1991,  1586,  1277,
+     1024,   820,   655,   526,   423,
+      335,   272,   215,   172,   137,
+      110,    87,    70,    56,    45,
+       36,    29,    23,    18,    15,
+};
 
-            // Si terminó durante este quantum → marcar como finalizado
-            if (procs[i].remaining <= 0) {
-                procs[i].alive = 0;
-                Mostrar("[INFO] PID=%d (%s) finalizado\n", procs[i].id, procs[i].name);
+#define CFS_VSCALE 1024              // vruntime en punto fijo (1/1024 de unidad)
+
+static RbTree cfs_tree;              // Ejecutables ordenados por (vruntime, PID)
+static int cfs_tree_ready = 0;       // ¿Se inicializó el árbol?
+static long long cfs_min_vruntime;   // vruntime mínimo monótono de la cola
+static long long cfs_total_weight;   // Peso de los ejecutables (árbol + CPU)
+static int cfs_latency = CFS_DEFAULT_LATENCY;
+static int cfs_min_gran = CFS_DEFAULT_MIN_GRAN;
+
+// Reloj de justicia: integral de dt / W(t). Un proceso de peso w
+// ejecutable entre V0 y V1 merece w * (V1 - V0) unidades de CPU
+static double cfs_fair_clock;
+static double cfs_dev_sum, cfs_dev_max; // Resumen de desviaciones
+static int cfs_done;                    // Procesos finalizados en la ejecución
+
+static int cfs_less(int a, int b, void *ctx) {
+    (void)ctx;
+    if (procs[a].vruntime != procs[b].vruntime) return procs[a].vruntime < procs[b].vruntime;
+    return procs[a].id < procs[b].id;   // Desempate estable por PID
+}
+
+// Actualiza vruntime, CPU recibida y reloj de justicia tras 'ran' unidades
+static void cfs_account(int slot, int ran) {
+    if (cfs_total_weight > 0) cfs_fair_clock += (double)ran / (double)cfs_total_weight;
+    procs[slot].vruntime += (long long)ran * CFS_NICE0_WEIGHT * CFS_VSCALE / procs[slot].weight;
+    procs[slot].cpu_recv += ran;
+}
+
+// min_vruntime solo avanza: evita que un recién llegado acapare la CPU
+static void cfs_update_min(void) {
+    int first = rb_first(&cfs_tree);
+    if (first != -1 && procs[first].vruntime > cfs_min_vruntime)
+        cfs_min_vruntime = procs[first].vruntime;
+}
+
+static void cfs_admit(int slot) {
+    if (procs[slot].vruntime < cfs_min_vruntime) procs[slot].vruntime = cfs_min_vruntime;
+    procs[slot].fair_v0 = cfs_fair_clock;
+    procs[slot].cpu_recv = 0;
+    cfs_total_weight += procs[slot].weight;
+    rb_insert(&cfs_tree, slot);
+}
+
+static int cfs_pick(void) {
+    int slot = rb_first(&cfs_tree);     // Menor vruntime: O(1)
+    if (slot != -1) rb_erase(&cfs_tree, slot); // Sale del árbol mientras ejecuta
+    return slot;
+}
+
+// Porción proporcional al peso dentro de la latencia objetivo
+static int cfs_slice(int slot) {
+    if (cfs_total_weight <= 0) return cfs_latency;
+    long long q = (long long)cfs_latency * procs[slot].weight / cfs_total_weight;
+    return q < cfs_min_gran ? cfs_min_gran : (int)q;
+}
+
+static void cfs_requeue(int slot, int ran) {
+    cfs_account(slot, ran);
+    rb_insert(&cfs_tree, slot);
+    cfs_update_min();
+}
+
+// Al terminar: comparar CPU recibida con el reparto ideal
+static void cfs_on_exit(int slot, int ran) {
+    cfs_account(slot, ran);
+    double ideal = procs[slot].weight * (cfs_fair_clock - procs[slot].fair_v0);
+    double dev = procs[slot].cpu_recv - ideal;
+    double adev = dev < 0 ? -dev : dev;
+    cfs_total_weight -= procs[slot].weight;
+
+    TRACE("   [INFO] PID=%d nice=%d: CPU=%d, ideal=%.2f, desviacion=%+.2f (%+.1f%%)\n",
+           procs[slot].id, procs[slot].nice, procs[slot].cpu_recv, ideal, dev,
+           ideal > 0 ? 100.0 * dev / ideal : 0.0);
+
+    cfs_dev_sum += adev;
+    if (adev > cfs_dev_max) cfs_dev_max = adev;
+    cfs_done++;
+}
+
+static void cfs_remove(int slot) {
+    if (!rb_contains(&cfs_tree, slot)) return;
+    rb_erase(&cfs_tree, slot);
+    cfs_total_weight -= procs[slot].weight;
+}
+
+static const SchedPolicy CFS_POLICY = {
+    .name = "CFS",
+    .admit = cfs_admit,
+    .pick = cfs_pick,
+    .slice = cfs_slice,
+    .requeue = cfs_requeue,
+    .on_exit = cfs_on_exit,
+    .remove = cfs_remove,
+};
+
+// ======================================================
+// 📌 proc_scheduler_cfs(latency, min_gran)
+// Reparte la CPU en proporción al peso de cada proceso.
+// Al final informa la desviación respecto al reparto ideal.
+// ======================================================
+void proc_scheduler_cfs(int latency, int min_gran) {
+    cfs_latency = latency > 0 ? latency : CFS_DEFAULT_LATENCY;
+    cfs_min_gran = min_gran > 0 ? min_gran : CFS_DEFAULT_MIN_GRAN;
+
+    if (!cfs_tree_ready) { rb_init(&cfs_tree, cfs_less, NULL); cfs_tree_ready = 1; }
+    rb_clear(&cfs_tree);
+    cfs_min_vruntime = 0;
+    cfs_total_weight = 0;
+    cfs_fair_clock = 0.0;
+    cfs_dev_sum = cfs_dev_max = 0.0;
+    cfs_done = 0;
+
+    Mostrar("\n[INFO] Iniciando scheduler CFS (latencia=%d, granularidad minima=%d unidades, reloj %s)\n",
+           cfs_latency, cfs_min_gran,
+           sim_clock_mode() == SIM_CLOCK_VIRTUAL ? "virtual" : "real");
+
+    sched_run(&CFS_POLICY);
+
+    if (cfs_done > 0)
+        Mostrar("[INFO] Justicia CFS: desviacion media=%.2f, maxima=%.2f unidades (%d procesos)\n\n",
+               cfs_dev_sum / cfs_done, cfs_dev_max, cfs_done);
+}
+
+// ======================================================
+// 📌 proc_set_nice(id, nice)
+// Cambia el nice (-20..19) y con él el peso del proceso.
+// Devuelve 0 si tuvo éxito o -1 si el PID no existe.
+// ======================================================
+int proc_set_nice(int id, int nice) {
+    int slot = slot_of(id);
+    if (slot == -1) return -1;
+    if (nice < -20) nice = -20;
+    if (nice > 19) nice = 19;
+    procs[slot].nice = nice;
+    procs[slot].weight = nice_to_weight[nice + 20];
+    return 0;
+}
+
+// ======================================================
+// 📌 Min-heap indexado (compartido por SRTF, SJF y EDF)
+// ih_pos[ranura] guarda su posición en el heap, de modo que
+// eliminar (proc_kill) o cambiar la clave (decrease-key)
+// de cualquier ranura cuesta O(log N) sin búsquedas.
+// ======================================================
+static int *ih_heap = NULL;       // Ranuras en orden de heap
+static int *ih_pos = NULL;        // Posición de cada ranura (-1 = fuera)
+static long long *ih_key = NULL;  // Clave de cada ranura
+static int ih_len = 0;            // Elementos en el heap
+static int ih_cap = 0;            // Ranuras cubiertas por ih_pos/ih_key
+
+// Orden: clave menor primero; a igual clave, PID menor (estable)
+static int ih_less(int a, int b) {
+    if (ih_key[a] != ih_key[b]) return ih_key[a] < ih_key[b];
+    return procs[a].id < procs[b].id;
+}
+
+// Coloca la ranura en la posición i y actualiza su índice
+static void ih_set(int i, int slot) {
+    ih_heap[i] = slot;
+    ih_pos[slot] = i;
+}
+
+static void ih_sift_up(int i) {
+    int slot = ih_heap[i];
+    while (i > 0) {
+        int parent = (i - 1) / 2;
+        if (!ih_less(slot, ih_heap[parent])) break;
+        ih_set(i, ih_heap[parent]);
+        i = parent;
+    }
+    ih_set(i, slot);
+}
+
+static void ih_sift_down(int i) {
+    int slot = ih_heap[i];
+    for (;;) {
+        int child = 2 * i + 1;
+        if (child >= ih_len) break;
+        if (child + 1 < ih_len && ih_less(ih_heap[child + 1], ih_heap[child])) child++;
+        if (!ih_less(ih_heap[child], slot)) break;
+        ih_set(i, ih_heap[child]);
+        i = child;
+    }
+    ih_set(i, slot);
+}
+
+// Vacía el heap y asegura espacio para toda la tabla actual
+static int ih_reset(void) {
+    if (ih_cap < table_cap) {
+        int *nh = realloc(ih_heap, (size_t)table_cap * sizeof(int));
+        if (!nh) return -1;
+        ih_heap = nh;
+        int *np = realloc(ih_pos, (size_t)table_cap * sizeof(int));
+        if (!np) return -1;
+        ih_pos = np;
+        long long *nk = realloc(ih_key, (size_t)table_cap * sizeof(long long));
+        if (!nk) return -1;
+        ih_key = nk;
+        ih_cap = table_cap;
+    }
+    for (int i = 0; i < ih_cap; ++i) ih_pos[i] = -1;
+    ih_len = 0;
+    return 0;
+}
+
+// Inserta una ranura con su clave: O(log N). Devuelve 0 o -1 sin memoria
+static int ih_push(int slot, long long key) {
+    if (slot >= ih_cap) {
+        // La tabla creció durante la ejecución: ampliar conservando el contenido
+        int old = ih_cap, len = ih_len;
+        ih_cap = 0;
+        if (ih_reset() == -1) { ih_cap = old; ih_len = len; return -1; }
+        for (int i = old; i < ih_cap; ++i) ih_pos[i] = -1;
+        for (int i = 0; i < len; ++i) ih_pos[ih_heap[i]] = i;
+        ih_len = len;
+    }
+    ih_key[slot] = key;
+    ih_heap[ih_len] = slot;
+    ih_pos[slot] = ih_len++;
+    ih_sift_up(ih_len - 1);
+    return 0;
+}
+
+// Ranura con menor clave (sin extraerla): O(1)
+static int ih_top(void) {
+    return ih_len > 0 ? ih_heap[0] : -1;
+}
+
+// Cambia la clave de una ranura presente (decrease/increase-key): O(log N)
+static void ih_update(int slot, long long key) {
+    int i = ih_pos[slot];
+    if (i < 0) return;
+    long long old = ih_key[slot];
+    ih_key[slot] = key;
+    if (key < old) ih_sift_up(i);
+    else ih_sift_down(i);
+}
+
+// Elimina una ranura cualquiera del heap: O(log N)
+static void ih_remove(int slot) {
+    if (slot >= ih_cap) return;
+    int i = ih_pos[slot];
+    if (i < 0) return;
+    ih_pos[slot] = -1;
+    int last = ih_heap[--ih_len];
+    if (i == ih_len) return;   // Era el último
+    ih_set(i, last);
+    if (i > 0 && ih_less(last, ih_heap[(i - 1) / 2])) ih_sift_up(i);
+    else ih_sift_down(i);
+}
+
+// Operaciones comunes: el proceso en CPU permanece en el heap,
+// así una llegada con mejor clave se detecta mirando la cima.
+static int heap_pick(void) { return ih_top(); }
+static int heap_slice(int slot) { return hot[slot].remaining; }
+static void heap_requeue(int slot, int ran) { (void)slot; (void)ran; } // Sigue en el heap
+static void heap_remove(int slot) { ih_remove(slot); }
+static void heap_on_exit(int slot, int ran) { (void)ran; ih_remove(slot); }
+
+// Un proceso que no pudo entrar al heap se descarta (si no, nunca
+// se planificaría) y se informa
+static void heap_admit_fail(int slot) {
+    Mostrar("[ERROR] Sin memoria para la cola de prioridad: PID=%d (%s) descartado\n",
+           procs[slot].id, procs[slot].name);
+    ready_count--;
+    slot_release(slot);
+}
+
+// ======================================================
+// 📌 SRTF / SJF: clave = tiempo restante
+// SRTF es expropiativo: cada unidad baja la clave del
+// proceso en CPU (decrease-key) y si otro queda en la cima,
+// toma la CPU. SJF no expropia: el elegido corre hasta el final.
+// ======================================================
+static void srtf_admit(int slot) {
+    if (ih_push(slot, hot[slot].remaining) == -1) heap_admit_fail(slot);
+}
+
+static int srtf_preempt(int slot) {
+    ih_update(slot, hot[slot].remaining);
+    return ih_top() != slot;
+}
+
+static const SchedPolicy SRTF_POLICY = {
+    .name = "SRTF",
+    .admit = srtf_admit,
+    .pick = heap_pick,
+    .slice = heap_slice,
+    .requeue = heap_requeue,
+    .on_exit = heap_on_exit,
+    .remove = heap_remove,
+    .preempt = srtf_preempt,
+};
+
+static const SchedPolicy SJF_POLICY = {
+    .name = "SJF",
+    .admit = srtf_admit,
+    .pick = heap_pick,
+    .slice = heap_slice,
+    .requeue = heap_requeue,
+    .on_exit = heap_on_exit,
+    .remove = heap_remove,
+};
+
+// ======================================================
+// 📌 EDF: clave = plazo absoluto (sin plazo = infinito)
+// Admisión: con el proceso nuevo (plazo d), la CPU pendiente de
+// los que vencen hasta cada plazo D >= d debe caber antes de D;
+// si algún plazo falla (el nuevo o uno ya admitido) se rechaza.
+// Los plazos vencidos al terminar cuentan como fallos.
+// ======================================================
+static int edf_misses = 0;       // Plazos incumplidos
+static int edf_rejected = 0;     // Rechazados por la prueba de admisión
+static int edf_done = 0;         // Procesos completados
+
+static long long edf_key(int slot) {
+    return procs[slot].deadline >= 0 ? procs[slot].deadline : LLONG_MAX;
+}
+
+// Plazo y CPU pendiente de un proceso (prueba de admisión)
+typedef struct { long long deadline; long long demand; } EdfJob;
+
+static EdfJob *edf_jobs = NULL;  // Búfer de la prueba de admisión
+static int edf_jobs_cap = 0;
+
+static int edf_job_cmp(const void *a, const void *b) {
+    long long x = ((const EdfJob *)a)->deadline, y = ((const EdfJob *)b)->deadline;
+    return (x > y) - (x < y);
+}
+
+// Prueba de demanda: ordena por plazo los procesos con plazo (los
+// admitidos más el nuevo) y comprueba la demanda acumulada en cada
+// plazo D >= d: O(N log N). Devuelve 1 si cabe, 0 si no y -1 sin
+// memoria; en *need y *at deja la demanda y el primer plazo que falla
+static int edf_feasible(int slot, long long d, long long *need, long long *at) {
+    if (ih_len + 1 > edf_jobs_cap) {
+        int ncap = edf_jobs_cap ? edf_jobs_cap : MAX_PROCS;
+        while (ncap < ih_len + 1) ncap *= 2;
+        EdfJob *nj = realloc(edf_jobs, (size_t)ncap * sizeof(EdfJob));
+        if (!nj) return -1;
+        edf_jobs = nj;
+        edf_jobs_cap = ncap;
+    }
+    int n = 0;
+    edf_jobs[n].deadline = d;
+    edf_jobs[n++].demand = hot[slot].remaining;
+    for (int i = 0; i < ih_len; ++i) {
+        int other = ih_heap[i];
+        if (procs[other].deadline < 0) continue;   // Sin plazo: no restringe
+        edf_jobs[n].deadline = ih_key[other];
+        edf_jobs[n++].demand = hot[other].remaining;
+    }
+    qsort(edf_jobs, (size_t)n, sizeof(EdfJob), edf_job_cmp);
+
+    long long now = sim_now(), demand = 0;
+    for (int i = 0; i < n; ++i) {
+        demand += edf_jobs[i].demand;
+        long long D = edf_jobs[i].deadline;
+        if (i + 1 < n && edf_jobs[i + 1].deadline == D) continue; // Sumar todo el plazo D
+        if (D >= d && now + demand > D) {
+            *need = demand;
+            *at = D;
+            return 0;
+        }
+    }
+    return 1;
+}
+
+static void edf_admit(int slot) {
+    long long d = procs[slot].deadline;
+    if (d >= 0) {
+        long long need = 0, at = d;
+        int ok = edf_feasible(slot, d, &need, &at);
+        if (ok == -1) { heap_admit_fail(slot); return; }
+        if (!ok) {
+            edf_rejected++;
+            Mostrar("[WARNING] EDF rechaza PID=%d (%s): habria %lld unidad(es) pendientes antes de t=%lld\n",
+                   procs[slot].id, procs[slot].name, need, at);
+            ready_count--;
+            slot_release(slot);
+            return;
+        }
+    }
+    if (ih_push(slot, edf_key(slot)) == -1) heap_admit_fail(slot);
+}
+
+static int edf_preempt(int slot) { return ih_top() != slot; }
+
+static void edf_on_exit(int slot, int ran) {
+    (void)ran;
+    ih_remove(slot);
+    edf_done++;
+    if (procs[slot].deadline >= 0 && sim_now() > procs[slot].deadline) {
+        edf_misses++;
+        TRACE("   [WARNING] PID=%d incumplio su plazo (t=%lld > %lld)\n",
+               procs[slot].id, sim_now(), procs[slot].deadline);
+    }
+}
+
+static const SchedPolicy EDF_POLICY = {
+    .name = "EDF",
+    .admit = edf_admit,
+    .pick = heap_pick,
+    .slice = heap_slice,
+    .requeue = heap_requeue,
+    .on_exit = edf_on_exit,
+    .remove = heap_remove,
+    .preempt = edf_preempt,
+};
+
+// ======================================================
+// 📌 proc_scheduler_srtf() / proc_scheduler_sjf() / proc_scheduler_edf()
+// Ejecutan el motor común sobre el min-heap indexado
+// ======================================================
+static void heap_run(const SchedPolicy *pol, const char *desc) {
+    if (ih_reset() == -1) {
+        Mostrar("[ERROR] Sin memoria para la cola de prioridad\n");
+        return;
+    }
+    Mostrar("\n[INFO] Iniciando scheduler %s (%s, reloj %s)\n", pol->name, desc,
+           sim_clock_mode() == SIM_CLOCK_VIRTUAL ? "virtual" : "real");
+    sched_run(pol);
+}
+
+void proc_scheduler_srtf(void) {
+    heap_run(&SRTF_POLICY, "menor tiempo restante, expropiativo");
+}
+
+void proc_scheduler_sjf(void) {
+    heap_run(&SJF_POLICY, "trabajo mas corto, no expropiativo");
+}
+
+void proc_scheduler_edf(void) {
+    edf_misses = edf_rejected = edf_done = 0;
+    heap_run(&EDF_POLICY, "plazo mas proximo, expropiativo");
+    Mostrar("[INFO] EDF: %d completado(s), %d plazo(s) incumplido(s), %d rechazado(s) en admision\n\n",
+           edf_done, edf_misses, edf_rejected);
+}
+
+// ======================================================
+// 📌 proc_set_deadline(id, rel)
+// Fija un plazo relativo al instante actual (EDF).
+// rel < 0 quita el plazo. Devuelve 0 o -1 si no existe.
+// ======================================================
+int proc_set_deadline(int id, int rel) {
+    int slot = slot_of(id);
+    if (slot == -1) return -1;
+    procs[slot].deadline = rel >= 0 ? sim_now() + rel : -1;
+    return 0;
+}
+
+// ======================================================
+// 📌 Simulación SMP con robo de trabajo
+// Un hilo real por núcleo simulado. Cada núcleo tiene una
+// deque sin bloqueos derivada de Chase-Lev: el dueño encola
+// abajo, pero a diferencia de Chase-Lev no desencola abajo (LIFO)
+// sino de arriba, con el mismo CAS que los ladrones, para
+// conservar el orden FIFO del Round-Robin local. Un proceso
+// que queda solo en su núcleo sigue ahí sin volver a la deque,
+// así no hay nada que robar y no rebota entre núcleos ociosos.
+// Cada núcleo lleva su propio reloj virtual: un proceso robado
+// no puede empezar antes de que su núcleo anterior lo soltara
+// (ready_at), así el tiempo ocioso se refleja en la utilización.
+// ======================================================
+#define WS_EMPTY (-1)   // Deque vacía
+#define WS_ABORT (-2)   // Otro hilo ganó la carrera: reintentar
+
+typedef struct {
+    long top;           // Próxima posición a robar (atómico)
+    long bottom;        // Próxima posición libre del dueño (atómico)
+    int *buf;           // Búfer circular de ranuras
+    long mask;          // Capacidad - 1 (potencia de 2)
+} WsDeque;
+
+// Estadísticas por núcleo, alineadas para evitar falso compartido
+typedef struct {
+    _Alignas(64) int id;
+    long long clock;        // Reloj virtual local
+    long long busy;         // Unidades ejecutando procesos
+    long long slices;       // Porciones de CPU despachadas
+    long long steals;       // Robos exitosos
+    long long steal_fails;  // CAS perdidos contra otro hilo (contención)
+    long long migrations;   // Procesos que venían de otro núcleo
+    long long completed;    // Procesos finalizados en este núcleo
+    long long switches;     // Cambios de contexto en este núcleo
+    int last_pid;           // Último PID que ejecutó (-1 = ninguno)
+    int idle;               // 1 si no encontró trabajo (no frena a los demás)
+    unsigned int rng;       // Semilla para elegir víctima
+    WsDeque dq;             // Cola local del núcleo
+    pthread_t th;           // Hilo que simula el núcleo
+} SmpCore;
+
+static SmpCore *smp_cores = NULL;
+static int smp_ncores = 0;
+static int smp_quantum = 1;
+static int smp_left = 0;                 // Procesos sin terminar (atómico)
+static long long smp_t0 = 0;             // Reloj global al iniciar
+static pthread_mutex_t table_lock = PTHREAD_MUTEX_INITIALIZER; // Protege slot_release
+static int smp_go = 0;                   // Salida simultánea de los núcleos (atómico)
+static int smp_steal_any = 0;            // Robar sin mirar relojes (faltan hilos)
+
+// El dueño encola al fondo (solo él escribe 'bottom')
+static void ws_push(WsDeque *d, int slot) {
+    long b = __atomic_load_n(&d->bottom, __ATOMIC_RELAXED);
+    __atomic_store_n(&d->buf[b & d->mask], slot, __ATOMIC_RELAXED);
+    __atomic_store_n(&d->bottom, b + 1, __ATOMIC_RELEASE);
+}
+
+// Procesos en la deque vistos por el dueño
+static long ws_size(WsDeque *d) {
+    return __atomic_load_n(&d->bottom, __ATOMIC_RELAXED) -
+           __atomic_load_n(&d->top, __ATOMIC_ACQUIRE);
+}
+
+// Extrae de arriba; válido para el dueño y para ladrones
+static int ws_steal(WsDeque *d) {
+    long t = __atomic_load_n(&d->top, __ATOMIC_ACQUIRE);
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    long b = __atomic_load_n(&d->bottom, __ATOMIC_ACQUIRE);
+    if (t >= b) return WS_EMPTY;
+    int slot = __atomic_load_n(&d->buf[t & d->mask], __ATOMIC_RELAXED);
+    if (!__atomic_compare_exchange_n(&d->top, &t, t + 1, 0,
+                                     __ATOMIC_SEQ_CST, __ATOMIC_RELAXED))
+        return WS_ABORT;
+    return slot;
+}
+
+// Transición atómica vivo → terminado. Devuelve 1 si este hilo la hizo
+static int proc_try_finish(int slot) {
+    int expected = 1;
+    return __atomic_compare_exchange_n(&hot[slot].alive, &expected, 0, 0,
+                                       __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+}
+
+// Extrae de una deque reintentando si otro hilo gana el CAS
+static int ws_take(SmpCore *c, WsDeque *d) {
+    int slot;
+    while ((slot = ws_steal(d)) == WS_ABORT) c->steal_fails++;
+    return slot;
+}
+
+// Busca trabajo: primero la cola propia, luego roba a otro núcleo.
+// Solo se roba a núcleos cuyo reloj va por delante: ellos empezarían
+// ese proceso más tarde que el ladrón (coherencia del tiempo virtual)
+static int smp_get_work(SmpCore *c) {
+    int slot = ws_take(c, &c->dq);
+    if (slot != WS_EMPTY) return slot;
+
+    // Elegir víctima al azar y recorrer el resto en orden
+    c->rng = c->rng * 1103515245u + 12345u;
+    int start = (int)((c->rng >> 16) % (unsigned int)smp_ncores);
+    for (int k = 0; k < smp_ncores; ++k) {
+        int v = (start + k) % smp_ncores;
+        if (v == c->id) continue;
+        if (!smp_steal_any &&
+            __atomic_load_n(&smp_cores[v].clock, __ATOMIC_RELAXED) <= c->clock) continue;
+        slot = ws_take(c, &smp_cores[v].dq);
+        if (slot != WS_EMPTY) { c->steals++; return slot; }
+    }
+    return WS_EMPTY;
+}
+
+// Reloj mínimo entre los núcleos con trabajo (los ociosos no cuentan)
+static long long smp_min_clock(void) {
+    long long m = LLONG_MAX;
+    for (int k = 0; k < smp_ncores; ++k) {
+        if (__atomic_load_n(&smp_cores[k].idle, __ATOMIC_RELAXED)) continue;
+        long long ck = __atomic_load_n(&smp_cores[k].clock, __ATOMIC_RELAXED);
+        if (ck < m) m = ck;
+    }
+    return m;
+}
+
+// ======================================================
+// 📌 smp_worker(arg)
+// Bucle de un núcleo: tomar, ejecutar un quantum, reencolar
+// ======================================================
+static void *smp_worker(void *arg) {
+    SmpCore *c = arg;
+    int held = WS_EMPTY;   // Proceso que sigue en este núcleo (deque vacía)
+    while (!__atomic_load_n(&smp_go, __ATOMIC_ACQUIRE)) sched_yield(); // Arrancar todos a la vez
+
+    while (__atomic_load_n(&smp_left, __ATOMIC_ACQUIRE) > 0) {
+        if (sched_control_wait()) break;   // Cancelado desde otro hilo
+
+        // Ventana de sincronización: nadie adelanta su reloj virtual más
+        // de un quantum al núcleo activo más atrasado
+        if (smp_ncores > 1 && c->clock > smp_min_clock() + smp_quantum) { sched_yield(); continue; }
+
+        int slot = held != WS_EMPTY ? held : smp_get_work(c);
+        held = WS_EMPTY;
+        if (slot == WS_EMPTY) {
+            __atomic_store_n(&c->idle, 1, __ATOMIC_RELAXED);
+            sched_yield();
+            continue;
+        }
+        __atomic_store_n(&c->idle, 0, __ATOMIC_RELAXED);
+
+        // Llegó desde otro núcleo → migración
+        if (procs[slot].last_core != -1 && procs[slot].last_core != c->id) c->migrations++;
+        procs[slot].last_core = c->id;
+
+        // No puede empezar antes de que lo soltara su núcleo anterior
+        if (procs[slot].ready_at > c->clock)
+            __atomic_store_n(&c->clock, procs[slot].ready_at, __ATOMIC_RELAXED);
+
+        int rem = __atomic_load_n(&hot[slot].remaining, __ATOMIC_ACQUIRE);
+        int exec = rem > smp_quantum ? smp_quantum : rem;
+        c->slices++;
+        c->switches += metrics_dispatch(slot, smp_t0 + c->clock, &c->last_pid);
+        TRACE("[OK] CPU%d: ejecutando PID=%d (%s) por %d unidad(es). Restante: %d\n",
+               c->id, procs[slot].id, procs[slot].name, exec, rem);
+
+        // Sin traza, la porción completa se consume de una vez
+        int step = sched_trace ? 1 : exec;
+        for (int t = 0; t < exec; t += step) {
+            sim_wait_units(step);  // Solo espera en modo REAL
+            rem = __atomic_sub_fetch(&hot[slot].remaining, step, __ATOMIC_ACQ_REL);
+            __atomic_store_n(&c->clock, c->clock + step, __ATOMIC_RELAXED); // Lo leen los ladrones
+            c->busy += step;
+            TRACE("   [OK] CPU%d PID=%d: ejecutado 1 unidad, resta %d\n",
+                   c->id, procs[slot].id, rem);
+        }
+        procs[slot].ready_at = c->clock;
+
+        if (rem <= 0) {
+            if (proc_try_finish(slot)) {
+                c->completed++;
+                __atomic_sub_fetch(&ready_count, 1, __ATOMIC_ACQ_REL);
+                TRACE("[INFO] CPU%d: PID=%d (%s) finalizado en t=%lld\n",
+                       c->id, procs[slot].id, procs[slot].name, smp_t0 + c->clock);
+                pthread_mutex_lock(&table_lock);
+                metrics_record(slot, smp_t0 + c->clock);
+                slot_release(slot);
+                pthread_mutex_unlock(&table_lock);
             }
+            __atomic_sub_fetch(&smp_left, 1, __ATOMIC_ACQ_REL);
+        } else if (ws_size(&c->dq) <= 0) {
+            held = slot;             // Fin de quantum sin nadie esperando: sigue aquí
+        } else {
+            ws_push(&c->dq, slot);   // Fin de quantum: al fondo de la cola local
         }
+    }
+    return NULL;
+}
+
+// ======================================================
+// 📌 proc_scheduler_smp(cores, quantum)
+// Reparte los procesos listos entre 'cores' núcleos (hilos)
+// y ejecuta Round-Robin local con robo de trabajo.
+// Informa utilización, robos y migraciones por núcleo.
+// ======================================================
+void proc_scheduler_smp(int cores, int quantum) {
+    if (cores <= 0) cores = 1;
+    if (cores > SMP_MAX_CORES) cores = SMP_MAX_CORES;
+    if (quantum <= 0) quantum = 1;
+
+    // Tomar todos los procesos listos de la cola global
+    int n = ready_count;
+    int *ready = malloc((size_t)(n > 0 ? n : 1) * sizeof(int));
+    long cap = 2;
+    while (cap <= n) cap *= 2;   // Cada deque puede llegar a tenerlos todos
+    SmpCore *cs = calloc((size_t)cores, sizeof(SmpCore));
+    int ok = ready && cs;
+    for (int k = 0; ok && k < cores; ++k) {
+        cs[k].dq.buf = malloc((size_t)cap * sizeof(int));
+        if (!cs[k].dq.buf) ok = 0;
+    }
+    if (!ok) {
+        if (cs) for (int k = 0; k < cores; ++k) free(cs[k].dq.buf);
+        free(cs); free(ready);
+        Mostrar("[ERROR] Sin memoria para la simulacion SMP\n");
+        return;
+    }
+
+    int count = 0, slot;
+    while (count < n && (slot = rq_pop(&readyq)) != -1) ready[count++] = slot;
+    if (proc_pending_arrivals() > 0)
+        Mostrar("[WARNING] SMP no reproduce llegadas: %d pendiente(s) para el proximo planificador\n",
+               proc_pending_arrivals());
+
+    Mostrar("\n[INFO] Iniciando scheduler SMP (%d nucleo(s), quantum=%d, %d proceso(s), reloj %s)\n",
+           cores, quantum, count,
+           sim_clock_mode() == SIM_CLOCK_VIRTUAL ? "virtual" : "real");
+
+    smp_cores = cs;
+    smp_ncores = cores;
+    smp_quantum = quantum;
+    smp_left = count;
+    smp_t0 = sim_now();
+    metrics_begin();
+
+    // Reparto inicial round-robin entre núcleos
+    for (int k = 0; k < cores; ++k) {
+        cs[k].id = k;
+        cs[k].last_pid = -1;
+        cs[k].rng = 0x9e3779b9u * (unsigned int)(k + 1);
+        cs[k].dq.mask = cap - 1;
+    }
+    for (int i = 0; i < count; ++i) {
+        procs[ready[i]].ready_at = 0;
+        ws_push(&cs[i % cores].dq, ready[i]);
+    }
+
+    struct timespec w0, w1;
+    clock_gettime(CLOCK_MONOTONIC, &w0);
+
+    smp_go = 0;
+    smp_steal_any = 0;
+    int started = 0;
+    for (int k = 0; k < cores; ++k) {
+        if (pthread_create(&cs[k].th, NULL, smp_worker, &cs[k]) != 0) break;
+        started++;
+    }
+    if (started < cores) {
+        // Faltan hilos: los presentes roban de cualquier deque para vaciarlas
+        Mostrar("[WARNING] Solo se pudieron crear %d de %d hilos\n", started, cores);
+        smp_steal_any = 1;
+    }
+    __atomic_store_n(&smp_go, 1, __ATOMIC_RELEASE);
+    if (started == 0) smp_worker(&cs[0]); // Sin hilos: simular en este mismo hilo
+    for (int k = 0; k < started; ++k) pthread_join(cs[k].th, NULL);
+
+    clock_gettime(CLOCK_MONOTONIC, &w1);
+    double wall = (double)(w1.tv_sec - w0.tv_sec) + (double)(w1.tv_nsec - w0.tv_nsec) / 1e9;
+
+    // Makespan = el reloj del núcleo que terminó más tarde
+    long long makespan = 0, busy = 0, steals = 0, migr = 0;
+    for (int k = 0; k < cores; ++k) {
+        if (cs[k].clock > makespan) makespan = cs[k].clock;
+        busy += cs[k].busy;
+        steals += cs[k].steals;
+        migr += cs[k].migrations;
+        mt_switches += cs[k].switches;
+    }
 
-        // Recalcular cuántos procesos quedan
-        remaining_procs = proc_count();
+    Mostrar("[INFO] Resumen SMP por nucleo:\n");
+    Mostrar("CPU\tOcupado\tUtil%%\tPorciones\tRobos\tConflictosCAS\tMigraciones\tFinalizados\n");
+    for (int k = 0; k < cores; ++k) {
+        Mostrar("%d\t%lld\t%.1f\t%lld\t\t%lld\t%lld\t\t%lld\t\t%lld\n",
+               k, cs[k].busy, makespan > 0 ? 100.0 * cs[k].busy / makespan : 0.0,
+               cs[k].slices, cs[k].steals, cs[k].steal_fails,
+               cs[k].migrations, cs[k].completed);
     }
+    Mostrar("[INFO] Makespan=%lld unidades, utilizacion media=%.1f%%, robos=%lld, migraciones=%lld\n",
+           makespan, makespan > 0 ? 100.0 * busy / ((double)makespan * cores) : 0.0, steals, migr);
+    Mostrar("[INFO] Tiempo de pared %.3f s (%.0f unidades simuladas/s)\n",
+           wall, wall > 0 ? busy / wall : 0.0);
+    int cancelled = __atomic_load_n(&ctl_cancel, __ATOMIC_ACQUIRE);
+    if (cancelled)
+        Mostrar("[WARNING] Scheduler SMP cancelado: %d proceso(s) vuelven a la cola de listos\n",
+               sched_requeue_all());
+    metrics_report(makespan);
+    if (!cancelled)
+        Mostrar("[INFO] Scheduler SMP finalizado en t=%lld. No quedan procesos listos.\n\n",
+               smp_t0 + makespan);
 
-    Mostrar("[INFO] Scheduler finalizado. No quedan procesos listos.\n\n");
+    sim_advance(makespan);
+    for (int k = 0; k < cores; ++k) free(cs[k].dq.buf);
+    free(cs);
+    free(ready);
+    smp_cores = NULL;
+    smp_ncores = 0;
 }
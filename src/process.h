@@ -5,42 +5,133 @@
 // 📌 Definiciones para la Gestión de Procesos
 // =====================================================
 
-// Número máximo de procesos que se pueden manejar simultáneamente
+// Capacidad inicial de la tabla de procesos (crece bajo demanda)
 #define MAX_PROCS 32
 
+// Límite superior de ranuras de la tabla dinámica
+#define PROC_TABLE_MAX (1 << 20)
+
+// Niveles de la cola multinivel con realimentación (MLFQ)
+#define MLFQ_MAX_LEVELS 32      // Un bit por nivel en el bitmap de prioridades
+#define MLFQ_DEFAULT_LEVELS 3
+
+// Parámetros por defecto de CFS (en unidades de tiempo)
+#define CFS_DEFAULT_LATENCY 6   // Periodo en que todos deberían ejecutar una vez
+#define CFS_DEFAULT_MIN_GRAN 1  // Porción mínima por despacho
+#define CFS_NICE0_WEIGHT 1024   // Peso de un proceso con nice 0
+
+// Núcleos máximos de la simulación SMP (un hilo por núcleo)
+#define SMP_MAX_CORES 64
+
 // =====================================================
-// 📌 Estructura que modela un Proceso
+// 📌 Estructuras que modelan un Proceso
 // =====================================================
+
+// Parte "caliente": lo que el planificador consulta en cada
+// despacho. Se guarda en un arreglo aparte para que muchas
+// entradas quepan en la misma línea de caché.
 typedef struct {
-    int id;             // Identificador único del proceso (PID)
-    char name[32];      // Nombre del proceso
-    int burst;          // Tiempo total requerido de CPU (unidades)
     int remaining;      // Tiempo restante por ejecutar
     int alive;          // Estado del proceso: 1 = activo, 0 = terminado
-    int mem_owner_id;   // ID del bloque de memoria asignado (o -1 si ninguno)
+} ProcHot;
+
+// Parte "fría": datos descriptivos que solo se leen al listar
+typedef struct {
+    int id;             // Identificador único del proceso (PID, -1 = ranura libre)
+    char name[32];      // Nombre del proceso
+    int burst;          // Tiempo total requerido de CPU (unidades)
+    int level;          // Nivel actual en MLFQ (0 = máxima prioridad)
+    int nice;           // Prioridad CFS (-20 = más CPU, 19 = menos CPU)
+    int weight;         // Peso CFS derivado del nice (1024 = nice 0)
+    long long vruntime; // Tiempo virtual CFS (punto fijo, 1/1024 de unidad)
+    double fair_v0;     // Reloj de justicia al ser admitido (reparto ideal)
+    int cpu_recv;       // Unidades de CPU recibidas en la ejecución actual
+    long long deadline; // Plazo absoluto para EDF (-1 = sin plazo)
+    int last_core;      // SMP: último núcleo donde ejecutó (-1 = ninguno)
+    long long ready_at; // SMP: instante en que quedó libre para otro núcleo
+    long long arrival;  // Métricas: instante de llegada (creación)
+    long long first_run;  // Métricas: primer despacho (-1 = aún no ejecutó)
+    long long completion; // Métricas: instante de finalización (-1 = pendiente)
+    int switches;       // Métricas: veces que recibió la CPU (cambios de contexto)
 } Proc;
 
 // =====================================================
 // 📌 Funciones de gestión de procesos
 // =====================================================
 
-// Inicializa la tabla de procesos, marcando todos como vacíos
+// Inicializa la tabla de procesos, marcando todas las ranuras como libres
 void proc_init();
 
-// Crea un nuevo proceso con nombre y ráfaga de CPU especificada
+// Crea un nuevo proceso con nombre y ráfaga de CPU especificada.
+// Reutiliza ranuras libres y hace crecer la tabla si hace falta.
 // Devuelve el PID del proceso creado o -1 en caso de error
 int proc_create(const char *name, int burst);
 
 // Lista en consola todos los procesos con su información básica
 void proc_list();
 
-// Retorna la cantidad de procesos activos con tiempo restante > 0
+// Retorna la cantidad de procesos activos con tiempo restante > 0 (O(1))
 int proc_count();
 
-// Planificador Round-Robin: ejecuta procesos en intervalos de 'quantum'
+// Planificador Round-Robin: ejecuta procesos en intervalos de 'quantum'.
+// El avance del tiempo lo marca el reloj de simulación (ver sim.h)
 void proc_scheduler_rr(int quantum);
 
-// Termina el proceso con el ID dado (marca como no activo)
+// Planificador MLFQ: 'levels' colas, quantum por nivel (lista 'quanta'
+// de 'nquanta' valores o NULL para 1,2,4...) y boost cada 'boost'
+// unidades (0 = sin boost). El nivel se elige con un bitmap en O(1)
+void proc_scheduler_mlfq(int levels, const int *quanta, int nquanta, int boost);
+
+// Planificador CFS: árbol rojo-negro por vruntime, elección O(log N).
+// 'latency' = periodo objetivo, 'min_gran' = porción mínima (0 = defecto)
+void proc_scheduler_cfs(int latency, int min_gran);
+
+// Cambia el nice (-20..19) del proceso y su peso en CFS.
+// Devuelve 0 si tuvo éxito o -1 si el PID no existe
+int proc_set_nice(int id, int nice);
+
+// Planificadores sobre un min-heap indexado con decrease-key:
+//  - SRTF: menor tiempo restante, expropiativo
+//  - SJF:  trabajo más corto, no expropiativo
+//  - EDF:  plazo más próximo, expropiativo, con prueba de admisión
+void proc_scheduler_srtf(void);
+void proc_scheduler_sjf(void);
+void proc_scheduler_edf(void);
+
+// Planificador SMP: 'cores' hilos reales, cada uno con su deque sin
+// bloqueos y robo de trabajo. Informa utilización, robos y migraciones
+void proc_scheduler_smp(int cores, int quantum);
+
+// Fija un plazo EDF relativo al instante actual (rel < 0 lo quita).
+// Devuelve 0 si tuvo éxito o -1 si el PID no existe
+int proc_set_deadline(int id, int rel);
+
+// Registra la llegada de un proceso 'at' unidades después del inicio
+// de la próxima ejecución del planificador, reservando 'mem' bytes
+// al llegar (0 = ninguno). Devuelve 0 o -1 sin memoria
+int proc_submit(long long at, const char *name, int burst, int mem);
+
+// Llegadas registradas que aún no se reprodujeron / descartarlas
+int proc_pending_arrivals(void);
+void proc_clear_arrivals(void);
+
+// Control de la ejecución en curso desde otro hilo (p.ej. la GUI):
+// pausa/reanuda el planificador o lo cancela. Al cancelar, los
+// procesos pendientes vuelven a la cola de listos
+void proc_sched_pause(int on);
+int proc_sched_paused(void);
+void proc_sched_cancel(void);
+
+// Quita la pausa y la cancelación pendientes. Quien controla la
+// ejecución lo llama antes de lanzar cada comando
+void proc_sched_reset(void);
+
+// Activa (1) o silencia (0) la traza por unidad y por despacho.
+// Sin traza, los planificadores solo imprimen los resúmenes finales
+void proc_set_trace(int on);
+int proc_trace(void);
+
+// Termina el proceso con el ID dado y libera su ranura
 // Devuelve 0 si tuvo éxito o -1 si el PID no es válido
 int proc_kill(int id);
 
@@ -0,0 +1,256 @@
+#include <stdlib.h>     // Para realloc, free
+#include "rbtree.h"     // Cabecera con RbTree y RbLink
+
+#define NIL (-1)        // Hijo/padre nulo
+#define OUT (-2)        // Marca de "fuera del árbol" en parent
+
+// Accesos cortos a los enlaces
+#define L(x)  (t->links[(x)].left)
+#define R(x)  (t->links[(x)].right)
+#define P(x)  (t->links[(x)].parent)
+#define RED(x) ((x) != NIL && t->links[(x)].red)
+
+void rb_init(RbTree *t, rb_less_fn less, void *ctx) {
+    t->links = NULL;
+    t->cap = 0;
+    t->root = NIL;
+    t->first = NIL;
+    t->count = 0;
+    t->less = less;
+    t->ctx = ctx;
+}
+
+void rb_free(RbTree *t) {
+    free(t->links);
+    rb_init(t, t->less, t->ctx);
+}
+
+void rb_clear(RbTree *t) {
+    for (int i = 0; i < t->cap; ++i) t->links[i].parent = OUT;
+    t->root = NIL;
+    t->first = NIL;
+    t->count = 0;
+}
+
+// Asegura enlaces para el elemento 'id' (crece al doble)
+static int rb_reserve(RbTree *t, int id) {
+    if (id < t->cap) return 0;
+    int ncap = t->cap ? t->cap : 32;
+    while (ncap <= id) ncap *= 2;
+    RbLink *nl = realloc(t->links, (size_t)ncap * sizeof(RbLink));
+    if (!nl) return -1;
+    for (int i = t->cap; i < ncap; ++i) nl[i].parent = OUT;
+    t->links = nl;
+    t->cap = ncap;
+    return 0;
+}
+
+int rb_contains(const RbTree *t, int id) {
+    return id >= 0 && id < t->cap && t->links[id].parent != OUT;
+}
+
+int rb_first(const RbTree *t) { return t->first; }
+
+int rb_next(const RbTree *t, int x) {
+    if (R(x) != NIL) {
+        x = R(x);
+        while (L(x) != NIL) x = L(x);
+        return x;
+    }
+    int p = P(x);
+    while (p != NIL && x == R(p)) { x = p; p = P(p); }
+    return p;
+}
+
+int rb_last(const RbTree *t) {
+    int x = t->root;
+    if (x == NIL) return NIL;
+    while (R(x) != NIL) x = R(x);
+    return x;
+}
+
+int rb_lower_bound(const RbTree *t, rb_below_fn below, const void *key) {
+    int x = t->root, found = NIL;
+    while (x != NIL) {
+        if (below(x, key)) x = R(x);
+        else { found = x; x = L(x); }
+    }
+    return found;
+}
+
+// Rotaciones clásicas (mantienen el orden en-orden)
+static void rotate_left(RbTree *t, int x) {
+    int y = R(x);
+    R(x) = L(y);
+    if (L(y) != NIL) P(L(y)) = x;
+    P(y) = P(x);
+    if (P(x) == NIL) t->root = y;
+    else if (x == L(P(x))) L(P(x)) = y;
+    else R(P(x)) = y;
+    L(y) = x;
+    P(x) = y;
+}
+
+static void rotate_right(RbTree *t, int x) {
+    int y = L(x);
+    L(x) = R(y);
+    if (R(y) != NIL) P(R(y)) = x;
+    P(y) = P(x);
+    if (P(x) == NIL) t->root = y;
+    else if (x == R(P(x))) R(P(x)) = y;
+    else L(P(x)) = y;
+    R(y) = x;
+    P(x) = y;
+}
+
+// ======================================================
+// 📌 rb_insert(t, id)
+// Inserción BST + recoloreado/rotaciones: O(log N)
+// ======================================================
+int rb_insert(RbTree *t, int z) {
+    if (rb_reserve(t, z) == -1) return -1;
+    if (rb_contains(t, z)) return 0;
+
+    // Descenso normal de árbol binario de búsqueda
+    int y = NIL, x = t->root, leftmost = 1;
+    while (x != NIL) {
+        y = x;
+        if (t->less(z, x, t->ctx)) x = L(x);
+        else { x = R(x); leftmost = 0; }
+    }
+    P(z) = y;
+    L(z) = R(z) = NIL;
+    t->links[z].red = 1;
+    if (y == NIL) t->root = z;
+    else if (t->less(z, y, t->ctx)) L(y) = z;
+    else R(y) = z;
+    if (leftmost) t->first = z;
+    t->count++;
+
+    // Restaurar propiedades rojo-negro
+    while (RED(P(z))) {
+        int p = P(z), g = P(p);
+        if (p == L(g)) {
+            int u = R(g);
+            if (RED(u)) {
+                t->links[p].red = 0; t->links[u].red = 0; t->links[g].red = 1;
+                z = g;
+            } else {
+                if (z == R(p)) { z = p; rotate_left(t, z); p = P(z); }
+                t->links[p].red = 0; t->links[g].red = 1;
+                rotate_right(t, g);
+            }
+        } else {
+            int u = L(g);
+            if (RED(u)) {
+                t->links[p].red = 0; t->links[u].red = 0; t->links[g].red = 1;
+                z = g;
+            } else {
+                if (z == L(p)) { z = p; rotate_right(t, z); p = P(z); }
+                t->links[p].red = 0; t->links[g].red = 1;
+                rotate_left(t, g);
+            }
+        }
+    }
+    t->links[t->root].red = 0;
+    return 0;
+}
+
+// Sustituye el subárbol u por v (v puede ser nulo)
+static void transplant(RbTree *t, int u, int v) {
+    if (P(u) == NIL) t->root = v;
+    else if (u == L(P(u))) L(P(u)) = v;
+    else R(P(u)) = v;
+    if (v != NIL) P(v) = P(u);
+}
+
+// ======================================================
+// 📌 rb_erase(t, id)
+// Borrado CLRS con padre explícito (los nulos no tienen
+// enlace propio): O(log N)
+// ======================================================
+void rb_erase(RbTree *t, int z) {
+    if (!rb_contains(t, z)) return;
+    if (t->first == z) t->first = rb_next(t, z);
+
+    int y = z, x, xp;
+    int y_red = t->links[y].red;
+    if (L(z) == NIL) {
+        x = R(z); xp = P(z);
+        transplant(t, z, R(z));
+    } else if (R(z) == NIL) {
+        x = L(z); xp = P(z);
+        transplant(t, z, L(z));
+    } else {
+        y = R(z);
+        while (L(y) != NIL) y = L(y);
+        y_red = t->links[y].red;
+        x = R(y);
+        if (P(y) == z) {
+            xp = y;
+        } else {
+            xp = P(y);
+            transplant(t, y, R(y));
+            R(y) = R(z);
+            P(R(y)) = y;
+        }
+        transplant(t, z, y);
+        L(y) = L(z);
+        P(L(y)) = y;
+        t->links[y].red = t->links[z].red;
+    }
+    t->links[z].parent = OUT;
+    t->count--;
+
+    if (y_red) return;
+
+    // Corregir el "doble negro" en x (que puede ser nulo)
+    while (x != t->root && !RED(x)) {
+        if (x == L(xp)) {
+            int w = R(xp);
+            if (RED(w)) {
+                t->links[w].red = 0; t->links[xp].red = 1;
+                rotate_left(t, xp);
+                w = R(xp);
+            }
+            if (!RED(L(w)) && !RED(R(w))) {
+                t->links[w].red = 1;
+                x = xp; xp = P(x);
+            } else {
+                if (!RED(R(w))) {
+                    t->links[L(w)].red = 0; t->links[w].red = 1;
+                    rotate_right(t, w);
+                    w = R(xp);
+                }
+                t->links[w].red = t->links[xp].red;
+                t->links[xp].red = 0;
+                if (R(w) != NIL) t->links[R(w)].red = 0;
+                rotate_left(t, xp);
+                x = t->root; xp = NIL;
+            }
+        } else {
+            int w = L(xp);
+            if (RED(w)) {
+                t->links[w].red = 0; t->links[xp].red = 1;
+                rotate_right(t, xp);
+                w = L(xp);
+            }
+            if (!RED(L(w)) && !RED(R(w))) {
+                t->links[w].red = 1;
+                x = xp; xp = P(x);
+            } else {
+                if (!RED(L(w))) {
+                    t->links[R(w)].red = 0; t->links[w].red = 1;
+                    rotate_left(t, w);
+                    w = L(xp);
+                }
+                t->links[w].red = t->links[xp].red;
+                t->links[xp].red = 0;
+                if (L(w) != NIL) t->links[L(w)].red = 0;
+                rotate_right(t, xp);
+                x = t->root; xp = NIL;
+            }
+        }
+    }
+    if (x != NIL) t->links[x].red = 0;
+}
@@ -0,0 +1,68 @@
+#ifndef RBTREE_H
+#define RBTREE_H
+
+// =====================================================
+// 📌 Árbol rojo-negro indexado (intrusivo por índice)
+// =====================================================
+// Los elementos se identifican por un índice entero >= 0 (p.ej.
+// la ranura de un proceso). El árbol guarda los enlaces en su
+// propio arreglo, indexado por ese mismo número, así los dueños
+// pueden reubicar sus datos (realloc) sin invalidar el árbol.
+// El orden lo define la función 'less' del usuario.
+
+// Devuelve != 0 si el elemento a va antes que b
+typedef int (*rb_less_fn)(int a, int b, void *ctx);
+
+// Devuelve != 0 si el elemento va antes que la clave buscada (en 'key')
+typedef int (*rb_below_fn)(int id, const void *key);
+
+// Enlaces de un elemento dentro del árbol
+typedef struct {
+    int left;     // Hijo izquierdo (-1 = nulo)
+    int right;    // Hijo derecho (-1 = nulo)
+    int parent;   // Padre (-1 = raíz, -2 = fuera del árbol)
+    int red;      // Color: 1 = rojo, 0 = negro
+} RbLink;
+
+typedef struct {
+    RbLink *links;     // Enlaces indexados por elemento
+    int cap;           // Elementos con enlaces reservados
+    int root;          // Raíz (-1 = árbol vacío)
+    int first;         // Mínimo en caché (-1 = vacío)
+    int count;         // Elementos en el árbol
+    rb_less_fn less;   // Orden total
+    void *ctx;         // Contexto para 'less'
+} RbTree;
+
+// Inicializa un árbol vacío con la función de orden dada
+void rb_init(RbTree *t, rb_less_fn less, void *ctx);
+
+// Libera los enlaces y deja el árbol vacío
+void rb_free(RbTree *t);
+
+// Vacía el árbol conservando la memoria reservada
+void rb_clear(RbTree *t);
+
+// Inserta el elemento 'id': O(log N). Devuelve 0 o -1 sin memoria
+int rb_insert(RbTree *t, int id);
+
+// Elimina el elemento 'id' si está en el árbol: O(log N)
+void rb_erase(RbTree *t, int id);
+
+// Indica si 'id' está actualmente en el árbol: O(1)
+int rb_contains(const RbTree *t, int id);
+
+// Mínimo del árbol (O(1), en caché) o -1 si está vacío
+int rb_first(const RbTree *t);
+
+// Sucesor en orden de 'id' o -1 si es el último
+int rb_next(const RbTree *t, int id);
+
+// Máximo del árbol o -1 si está vacío: O(log N)
+int rb_last(const RbTree *t);
+
+// Primer elemento que no va antes que 'key' (cota inferior)
+// o -1 si todos van antes: O(log N)
+int rb_lower_bound(const RbTree *t, rb_below_fn below, const void *key);
+
+#endif // RBTREE_H
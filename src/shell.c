@@ -2,12 +2,19 @@
 #include <string.h>    // Manejo de cadenas (strcmp, strtok, strlen, etc.)
 #include <stdlib.h>    // Funciones estándar (atoi, malloc, free, etc.)
 #include <locale.h>    // Configuración regional (para soporte de UTF-8 en consola)
+#include <errno.h>     // ERANGE (números fuera de rango)
+#include <limits.h>    // INT_MAX
 
 #include "shell.h"
 #include "log.h"
 #include "process.h"   // Módulo de gestión de procesos
 #include "memory.h"    // Módulo de gestión de memoria
 #include "fs.h"        // Módulo de sistema de archivos virtual
+#include "sim.h"       // Reloj de simulación (modo virtual / real)
+#include "workload.h"  // Trazas de carga y generador sintético
+#include "slab.h"      // Cachés de objetos (slab)
+#include "paging.h"    // Memoria virtual paginada
+#include "tcache.h"    // Cachés por hilo (estrés concurrente)
 
 #ifdef _WIN32
 #define strcasecmp _stricmp // Compatibilidad con Windows (strcasecmp no existe)
@@ -16,6 +23,22 @@
 #define PROMPT "CinnamStrawbOS> " // Prefijo del shell interactivo
 #define VFS_FILE "vfs.dat"        // Nombre del archivo persistente del VFS
 
+// ======================================================
+// 📌 Función: shell_configure(argc, argv)
+// Opciones de arranque: --memoria <tamano[K|M|G]> y --huge
+// ======================================================
+void shell_configure(int argc, char **argv)
+{
+    long long size = MEM_SIZE;
+    int huge = 0;
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--memoria") == 0 && i + 1 < argc) size = mem_parse_size(argv[++i]);
+        else if (strcmp(argv[i], "--huge") == 0) huge = 1;
+    }
+    if (mem_configure(size, huge) == -1)
+        Mostrar("[WARNING] Tamano de memoria invalido; se usan %d bytes\n", MEM_SIZE);
+}
+
 // ======================================================
 // 📌 Función: print_ayuda()
 // Muestra el menú de ayuda con todos los comandos soportados
@@ -31,25 +54,63 @@ void print_ayuda(void)
     // 🧑‍💻 Procesos
     Mostrar("📌  Gestion de Procesos\n");
     Mostrar("──────────────────────────────────────────────────────────────\n");
-    Mostrar("  🔹 NuevoProceso <Nombre> <Rafaga>   → Crear proceso (rafaga en unidades)\n");
+    Mostrar("  🔹 NuevoProceso <Nombre> <Rafaga> [Plazo] → Crear proceso (rafaga y plazo EDF en unidades)\n");
     Mostrar("  🔹 ListarProcesos                   → Listar procesos activos\n");
     Mostrar("  🔹 Ejecutar [Intervalo]             → Ejecutar planificador Round-Robin\n");
-    Mostrar("  🔹 TerminarProceso <Id_Proceso>     → Terminar un proceso especifico\n\n");
+    Mostrar("  🔹 EjecutarSMP <Nucleos> [Intervalo] → Round-Robin multinucleo con robo de trabajo\n");
+    Mostrar("  🔹 EjecutarMLFQ [Niveles] [Q0,Q1,..] [Boost] → Planificador multinivel con realimentacion\n");
+    Mostrar("  🔹 EjecutarCFS [Latencia] [GranMin] → Planificador justo por vruntime (CFS)\n");
+    Mostrar("  🔹 CambiarNice <Id_Proceso> <Nice>  → Ajustar prioridad CFS (-20..19)\n");
+    Mostrar("  🔹 EjecutarSRTF | EjecutarSJF       → Menor tiempo restante / trabajo mas corto\n");
+    Mostrar("  🔹 EjecutarEDF                      → Plazo mas proximo primero (con admision)\n");
+    Mostrar("  🔹 TerminarProceso <Id_Proceso>     → Terminar un proceso especifico\n");
+    Mostrar("  🔹 ModoReloj <virtual|real> [ms]    → Reloj simulado instantaneo o a ritmo real\n");
+    Mostrar("  🔹 ReproducirTraza <Archivo> [Politica] [Q] → Llegadas de una traza (rr|mlfq|cfs|srtf|sjf|edf)\n");
+    Mostrar("  🔹 GenerarCarga <Tipo> <N> [Semilla] [Archivo] → Carga poisson|bimodal|pareto reproducible\n");
+    Mostrar("  🔹 Traza <on|off>                   → Detalle por unidad o solo resumenes y metricas\n\n");
 
     // 💾 Memoria
     Mostrar("📌  Gestion de Memoria\n");
     Mostrar("──────────────────────────────────────────────────────────────\n");
     Mostrar("  🔹 AsignarMemoria <Id_Proceso> <Tamano_Bytes> → Asignar memoria al proceso\n");
     Mostrar("  🔹 LiberarMemoria <Id_Proceso>                → Liberar memoria del proceso\n");
-    Mostrar("  🔹 MostrarMapaMemoria                         → Mostrar mapa de memoria\n\n");
+    Mostrar("  🔹 LiberarBloque <Idx>                        → Liberar un solo bloque (fusion O(1))\n");
+    Mostrar("  🔹 MostrarMapaMemoria                         → Mostrar mapa de memoria\n");
+    Mostrar("  🔹 PoliticaMemoria <Politica>                 → Politica: first, segregada, best, worst o next\n");
+    Mostrar("  🔹 ReiniciarMemoria [lista|buddy] [Tamano] [huge|nohuge] → Reiniciar la memoria (modo y tamano)\n");
+    Mostrar("  🔹 EscribirMemoria <Id> <Bloque> <Offset> <Texto> → Escribir bytes en un bloque del proceso\n");
+    Mostrar("  🔹 LeerMemoria <Id> <Bloque> <Offset> <N>      → Leer bytes de un bloque del proceso\n");
+    Mostrar("  🔹 AnchoBandaMemoria [Pasadas]                → Medir escritura/lectura real de los bloques de procesos\n");
+    Mostrar("  🔹 EstresMemoria <Hilos> [Ops] [Semilla]      → Hilos concurrentes con y sin cache por hilo\n");
+    Mostrar("  🔹 CompactarMemoria                           → Juntar todo lo libre en un bloque final\n");
+    Mostrar("  🔹 AutoCompactar <on|off>                     → Compactar al fallar por fragmentacion\n");
+    Mostrar("  🔹 CrearCache <Nombre> <Tamano_Objeto>        → Crear una cache slab de objetos\n");
+    Mostrar("  🔹 AsignarObjeto <Cache>                      → Asignar un objeto de la cache (O(1))\n");
+    Mostrar("  🔹 LiberarObjeto <Cache> <Id_Objeto>          → Liberar un objeto de la cache (O(1))\n");
+    Mostrar("  🔹 DestruirCache <Cache>                      → Destruir la cache y devolver sus paginas\n\n");
+
+    // 📄 Paginación
+    Mostrar("📌  Memoria Virtual Paginada\n");
+    Mostrar("──────────────────────────────────────────────────────────────\n");
+    Mostrar("  🔹 Paginacion <Marcos|off> [fifo|lru|clock] [Conjuntos] [Vias] → Crear el pool de marcos y la TLB\n");
+    Mostrar("  🔹 ReferenciasPaginas <Archivo>               → Ejecutar una cadena de referencias (pid direccion)\n");
+    Mostrar("  🔹 ReferenciasSinteticas <N> <Procesos> <Paginas> [Semilla] → Referencias con localidad\n\n");
 
     // 📂 Archivos
     Mostrar("📌  Sistema de Archivos Virtual (VFS)\n");
     Mostrar("──────────────────────────────────────────────────────────────\n");
     Mostrar("  🔹 CrearArchivo <Nombre>        → Crear archivo en VFS\n");
-    Mostrar("  🔹 ListarArchivos               → Listar archivos en VFS\n");
+    Mostrar("  🔹 ListarArchivos [Ruta]        → Listar un directorio (por defecto el actual)\n");
+    Mostrar("  🔹 CrearDirectorio <Ruta>       → Crear un directorio\n");
+    Mostrar("  🔹 EliminarDirectorio <Ruta>    → Eliminar un directorio vacio\n");
+    Mostrar("  🔹 CambiarDirectorio <Ruta>     → Cambiar el directorio actual (admite . y ..)\n");
+    Mostrar("  🔹 DirectorioActual             → Mostrar la ruta del directorio actual\n");
     Mostrar("  🔹 MostrarContenido <Nombre>    → Mostrar contenido de un archivo\n");
     Mostrar("  🔹 EscribirArchivo <Nombre>     → Escribir contenido en un archivo\n");
+    Mostrar("  🔹 AnexarArchivo <Nombre> <Texto> → Agregar una linea al final\n");
+    Mostrar("  🔹 LeerArchivo <Nombre> <Offset> <N> → Leer N bytes desde un offset\n");
+    Mostrar("  🔹 EscribirEnArchivo <Nombre> <Offset> <Texto> → Sobrescribir desde un offset\n");
+    Mostrar("  🔹 TruncarArchivo <Nombre> <Tamano> → Cambiar el tamano del archivo\n");
     Mostrar("  🔹 EliminarArchivo <Nombre>     → Eliminar archivo del VFS\n");
     Mostrar("  🔹 GuardarFS                    → Guardar VFS en disco (vfs.dat)\n");
     Mostrar("  🔹 CargarFS                     → Cargar VFS desde disco (vfs.dat)\n\n");
@@ -66,13 +127,65 @@ void print_ayuda(void)
     Mostrar("╚══════════════════════════════════════════════════════════════╝\n\n");
 }
 
+// Ejecuta el planificador indicado por nombre (rr, mlfq, cfs, srtf, sjf, edf).
+// Devuelve 0 o -1 si el nombre no existe
+static int run_policy(const char *name, int quantum)
+{
+    if (strcasecmp(name, "rr") == 0) proc_scheduler_rr(quantum);
+    else if (strcasecmp(name, "mlfq") == 0) proc_scheduler_mlfq(MLFQ_DEFAULT_LEVELS, NULL, 0, 0);
+    else if (strcasecmp(name, "cfs") == 0) proc_scheduler_cfs(0, 0);
+    else if (strcasecmp(name, "srtf") == 0) proc_scheduler_srtf();
+    else if (strcasecmp(name, "sjf") == 0) proc_scheduler_sjf();
+    else if (strcasecmp(name, "edf") == 0) proc_scheduler_edf();
+    else return -1;
+    return 0;
+}
+
+// Deja imprimible un trozo de archivo: NUL y los demás caracteres de
+// control (salvo \n, \t y \r) pasan a '.' y se cierra con '\0'. Los
+// bytes >= 0x80 no se tocan para no romper el texto UTF-8 (ñ, á, ...)
+static void printable(char *buf, long long n)
+{
+    for (long long k = 0; k < n; ++k) {
+        unsigned char c = (unsigned char)buf[k];
+        if (c < 32 && c != '\n' && c != '\t' && c != '\r') buf[k] = '.';
+    }
+    buf[n] = '\0';
+}
+
+// Largo de 'buf' sin una secuencia UTF-8 incompleta al final, para no
+// partir un carácter entre dos trozos
+static long long utf8_cut(const char *buf, long long n)
+{
+    for (long long k = n - 1, back = 1; k >= 0 && back <= 4; --k, ++back) {
+        unsigned char c = (unsigned char)buf[k];
+        if ((c & 0xC0) == 0x80) continue;   // Byte de continuación
+        int need = c >= 0xF0 ? 4 : c >= 0xE0 ? 3 : c >= 0xC0 ? 2 : 1;
+        return need > back ? k : n;
+    }
+    return n;
+}
+
+// Convierte 's' a entero completo (sin texto de sobra). Retorna 0 o -1
+// si no es un número, a diferencia de atoll que devolvería 0
+static int parse_ll(const char *s, long long *out)
+{
+    char *end;
+    errno = 0;
+    long long v = strtoll(s, &end, 10);
+    if (end == s || *end != '\0' || errno == ERANGE) return -1;
+    *out = v;
+    return 0;
+}
+
 // Inicializa todos los subsistemas del SO y muestra banner de bienvenida
 void shell_init(void)
 {   
 
     // Inicialización de subsistemas
     proc_init();            // Inicializa gestor de procesos
-    mem_init();             // Inicializa gestor de memoria
+    if (mem_init() == -1)   // Inicializa gestor de memoria (reserva la arena)
+        Mostrar("[WARNING] No se pudo reservar la arena pedida; se usan %lld bytes\n", mem_total());
     fs_init();              // Inicializa sistema de archivos
     fs_load(VFS_FILE);      // Intenta cargar sistema de archivos desde disco
 
@@ -115,9 +228,14 @@ int shell_handle_line(char *line)
     else if (strcasecmp(cmd, "NuevoProceso") == 0) {
         char *name = strtok(NULL, " ");
         char *burst_s = strtok(NULL, " ");
-        if (!name || !burst_s) { Mostrar("Uso: NuevoProceso <name> <burst>\n"); return 0; }
+        char *dl_s = strtok(NULL, " ");  // Plazo opcional (EDF)
+        if (!name || !burst_s) { Mostrar("Uso: NuevoProceso <name> <burst> [deadline]\n"); return 0; }
         int burst = atoi(burst_s); // Convierte argumento a número
-            proc_create(name, burst);  // Crea nuevo proceso
+        int pid = proc_create(name, burst);  // Crea nuevo proceso
+        if (pid != -1 && dl_s) {
+            proc_set_deadline(pid, atoi(dl_s));
+            Mostrar("[INFO] PID=%d con plazo de %d unidad(es)\n", pid, atoi(dl_s));
+        }
     }
     else if (strcasecmp(cmd, "ListarProcesos") == 0) {
         proc_list();
@@ -127,12 +245,116 @@ int shell_handle_line(char *line)
         int quantum = q ? atoi(q) : 1;   // Quantum por defecto = 1
         proc_scheduler_rr(quantum);      // Ejecuta planificador RR
     }
+    else if (strcasecmp(cmd, "EjecutarSMP") == 0) {
+        char *cores_s = strtok(NULL, " ");
+        char *q = strtok(NULL, " ");
+        if (!cores_s) { Mostrar("Uso: EjecutarSMP <nucleos> [quantum]\n"); return 0; }
+        proc_scheduler_smp(atoi(cores_s), q ? atoi(q) : 1);
+    }
+    else if (strcasecmp(cmd, "EjecutarMLFQ") == 0) {
+        char *lv_s = strtok(NULL, " ");
+        char *q_s = strtok(NULL, " ");
+        char *boost_s = strtok(NULL, " ");
+        int levels = lv_s ? atoi(lv_s) : MLFQ_DEFAULT_LEVELS;
+
+        // Quantums por nivel separados por comas: "2,4,8"
+        int quanta[MLFQ_MAX_LEVELS];
+        int nq = 0;
+        for (char *t = q_s; t && *t && nq < MLFQ_MAX_LEVELS; ) {
+            quanta[nq++] = atoi(t);
+            t = strchr(t, ',');
+            if (t) t++;
+        }
+        int boost = boost_s ? atoi(boost_s) : 0;
+        proc_scheduler_mlfq(levels, nq > 0 ? quanta : NULL, nq, boost);
+    }
+    else if (strcasecmp(cmd, "EjecutarCFS") == 0) {
+        char *lat_s = strtok(NULL, " ");
+        char *gran_s = strtok(NULL, " ");
+        proc_scheduler_cfs(lat_s ? atoi(lat_s) : 0, gran_s ? atoi(gran_s) : 0);
+    }
+    else if (strcasecmp(cmd, "CambiarNice") == 0) {
+        char *pid_s = strtok(NULL, " ");
+        char *nice_s = strtok(NULL, " ");
+        if (!pid_s || !nice_s) { Mostrar("Uso: CambiarNice <pid> <nice>\n"); return 0; }
+        int pid = atoi(pid_s), nice = atoi(nice_s);
+        if (proc_set_nice(pid, nice) == -1) Mostrar("[WARNING] No existe el proceso PID=%d\n", pid);
+        else Mostrar("[OK] PID=%d ahora tiene nice=%d\n", pid, nice < -20 ? -20 : (nice > 19 ? 19 : nice));
+    }
+    else if (strcasecmp(cmd, "EjecutarSRTF") == 0) {
+        proc_scheduler_srtf();
+    }
+    else if (strcasecmp(cmd, "EjecutarSJF") == 0) {
+        proc_scheduler_sjf();
+    }
+    else if (strcasecmp(cmd, "EjecutarEDF") == 0) {
+        proc_scheduler_edf();
+    }
     else if (strcasecmp(cmd, "TerminarProceso") == 0) {
         char *pid_s = strtok(NULL, " ");
         if (!pid_s) { Mostrar("Uso: TerminarProceso <pid>\n"); return 0; }
         int pid = atoi(pid_s);
         proc_kill(pid); // Elimina proceso específico
     }
+    else if (strcasecmp(cmd, "ReproducirTraza") == 0) {
+        char *path = strtok(NULL, " ");
+        char *pol_s = strtok(NULL, " ");
+        char *q = strtok(NULL, " ");
+        if (!path) { Mostrar("Uso: ReproducirTraza <archivo> [rr|mlfq|cfs|srtf|sjf|edf] [quantum]\n"); return 0; }
+        proc_clear_arrivals();
+        int n = wl_load(path);
+        if (n == -1) { Mostrar("[WARNING] No se pudo abrir la traza %s\n", path); return 0; }
+        Mostrar("[OK] Traza %s: %d llegada(s)\n", path, n);
+        if (run_policy(pol_s ? pol_s : "rr", q ? atoi(q) : 1) == -1) {
+            Mostrar("[WARNING] Planificador desconocido: %s (llegadas quedan pendientes)\n", pol_s);
+        }
+    }
+    else if (strcasecmp(cmd, "GenerarCarga") == 0) {
+        char *kind = strtok(NULL, " ");
+        char *n_s = strtok(NULL, " ");
+        char *seed_s = strtok(NULL, " ");
+        char *path = strtok(NULL, " ");
+        if (!kind || !n_s) { Mostrar("Uso: GenerarCarga <poisson|bimodal|pareto> <n> [semilla] [archivo]\n"); return 0; }
+        int n = atoi(n_s);
+        unsigned long long seed = seed_s ? strtoull(seed_s, NULL, 10) : 1;
+        if (wl_generate(kind, n, seed, path) == -1) {
+            Mostrar("[WARNING] No se pudo generar la carga (tipo valido, n > 0 y archivo escribible?)\n");
+        } else if (path) {
+            Mostrar("[OK] Carga %s de %d llegada(s) (semilla %llu) guardada en %s\n", kind, n, seed, path);
+        } else {
+            Mostrar("[OK] Carga %s de %d llegada(s) (semilla %llu) lista: %d pendiente(s) para el proximo planificador\n",
+                   kind, n, seed, proc_pending_arrivals());
+        }
+    }
+    else if (strcasecmp(cmd, "Traza") == 0) {
+        char *on_s = strtok(NULL, " ");
+        if (!on_s) {
+            Mostrar("[INFO] Traza %s\n", proc_trace() ? "activada" : "desactivada");
+            Mostrar("Uso: Traza <on|off>\n");
+            return 0;
+        }
+        if (strcasecmp(on_s, "on") == 0) proc_set_trace(1);
+        else if (strcasecmp(on_s, "off") == 0) proc_set_trace(0);
+        else { Mostrar("Uso: Traza <on|off>\n"); return 0; }
+        Mostrar("[OK] Traza %s\n", proc_trace() ? "activada (detalle por unidad)" : "desactivada (solo resumenes)");
+    }
+    else if (strcasecmp(cmd, "ModoReloj") == 0) {
+        char *mode_s = strtok(NULL, " ");
+        char *ms_s = strtok(NULL, " ");
+        if (!mode_s) {
+            Mostrar("[INFO] Reloj actual: %s (%d ms/unidad en modo real), t=%lld\n",
+                   sim_clock_mode() == SIM_CLOCK_VIRTUAL ? "virtual" : "real",
+                   sim_ms_per_unit(), sim_now());
+            Mostrar("Uso: ModoReloj <virtual|real> [ms_por_unidad]\n");
+            return 0;
+        }
+        int ms = ms_s ? atoi(ms_s) : 0;  // 0 = conservar valor actual
+        if (strcasecmp(mode_s, "virtual") == 0) sim_set_clock(SIM_CLOCK_VIRTUAL, ms);
+        else if (strcasecmp(mode_s, "real") == 0) sim_set_clock(SIM_CLOCK_REAL, ms);
+        else { Mostrar("Uso: ModoReloj <virtual|real> [ms_por_unidad]\n"); return 0; }
+        Mostrar("[OK] Reloj en modo %s (%d ms/unidad en modo real)\n",
+               mode_s, sim_ms_per_unit());
+    }
 
     // =============================
     //  Bloque de Memoria
@@ -142,22 +364,268 @@ int shell_handle_line(char *line)
         char *pid_s = strtok(NULL, " ");
         char *size_s = strtok(NULL, " ");
         if (!pid_s || !size_s) { Mostrar("Uso: AsignarMemoria <pid> <size>\n"); return 0; }
-        int pid = atoi(pid_s), size = atoi(size_s);
+        int pid = atoi(pid_s);
+        long long size = mem_parse_size(size_s);  // Admite sufijos K, M y G
+        if (pid < 0) { Mostrar("[WARNING] PID invalido: %d\n", pid); return 0; }
         int blk = mem_alloc(pid, size);
         if (blk == -1) Mostrar("[ERROR] Fallo la asignacion de memoria (no hay fit o limite)\n");
-        else Mostrar("[OK] Memoria asignada (block idx=%d) para PID=%d\n", blk, pid);
+        else {
+            MemOwnerUsage mu;
+            mem_owner_usage(pid, &mu);
+            Mostrar("[OK] Memoria asignada (block idx=%d) para PID=%d (total %lld bytes en %d bloque(s))\n",
+                   blk, pid, mu.bytes, mu.blocks);
+        }
     }
     else if (strcasecmp(cmd, "LiberarMemoria") == 0) {
         char *pid_s = strtok(NULL, " ");
         if (!pid_s) { Mostrar("Uso: LiberarMemoria <pid>\n"); return 0; }
         int pid = atoi(pid_s);
-        int freed = mem_free_by_owner(pid); // Libera memoria del proceso
+        if (pid < 0) {
+            Mostrar("[WARNING] Las paginas slab y los marcos se liberan con DestruirCache / Paginacion off\n");
+            return 0;
+        }
+        MemOwnerUsage mu;
+        mem_owner_usage(pid, &mu);
+        int freed = mem_free_by_owner(pid); // Libera memoria del proceso: O(bloques que posee)
         if (freed == 0) Mostrar("[WARNING] No se encontraron bloques para PID=%d\n", pid);
-        else Mostrar("[INFO] Liberados %d bloque(s) para PID=%d\n", freed, pid);
+        else Mostrar("[INFO] Liberados %d bloque(s) (%lld bytes) para PID=%d\n", freed, mu.bytes, pid);
+    }
+    else if (strcasecmp(cmd, "LiberarBloque") == 0) {
+        char *idx_s = strtok(NULL, " ");
+        if (!idx_s) { Mostrar("Uso: LiberarBloque <idx>\n"); return 0; }
+        int idx = atoi(idx_s);
+        if (mem_block_owner(idx) == MEM_OWNER_SLAB) { Mostrar("[WARNING] El bloque %d es una pagina slab (usa DestruirCache)\n", idx); return 0; }
+        if (mem_block_owner(idx) == MEM_OWNER_PAGING) { Mostrar("[WARNING] El bloque %d tiene los marcos de paginacion (usa Paginacion off)\n", idx); return 0; }
+        if (mem_free_block(idx) == -1) Mostrar("[WARNING] El bloque %d no existe o ya esta libre\n", idx);
+        else Mostrar("[OK] Bloque %d liberado\n", idx);
     }
     else if (strcasecmp(cmd, "MostrarMapaMemoria") == 0) {
         mem_map(); // Muestra estado de la memoria
     }
+    else if (strcasecmp(cmd, "PoliticaMemoria") == 0) {
+        char *pol_s = strtok(NULL, " ");
+        if (!pol_s) {
+            Mostrar("[INFO] Politica de memoria actual: %s\n", mem_policy_name(mem_get_policy()));
+            Mostrar("Uso: PoliticaMemoria <first|segregada|best|worst|next>\n");
+            return 0;
+        }
+        if (strcasecmp(pol_s, "first") == 0) mem_set_policy(MEM_FIRST_FIT);
+        else if (strcasecmp(pol_s, "segregada") == 0) mem_set_policy(MEM_SEG_FIT);
+        else if (strcasecmp(pol_s, "best") == 0) mem_set_policy(MEM_BEST_FIT);
+        else if (strcasecmp(pol_s, "worst") == 0) mem_set_policy(MEM_WORST_FIT);
+        else if (strcasecmp(pol_s, "next") == 0) mem_set_policy(MEM_NEXT_FIT);
+        else { Mostrar("Uso: PoliticaMemoria <first|segregada|best|worst|next>\n"); return 0; }
+        Mostrar("[OK] Politica de memoria: %s\n", mem_policy_name(mem_get_policy()));
+        if (mem_get_mode() == MEM_MODE_BUDDY)
+            Mostrar("[INFO] La memoria esta en modo buddy: la politica se aplica tras ReiniciarMemoria lista\n");
+    }
+    else if (strcasecmp(cmd, "ReiniciarMemoria") == 0) {
+        mem_mode_t mode = mem_get_mode();
+        long long size = -1;
+        int huge = -1;       // -1: sin indicar, se conserva el actual
+        char *opt;
+        while ((opt = strtok(NULL, " ")) != NULL) {
+            if (strcasecmp(opt, "lista") == 0) mode = MEM_MODE_LIST;
+            else if (strcasecmp(opt, "buddy") == 0) mode = MEM_MODE_BUDDY;
+            else if (strcasecmp(opt, "huge") == 0) huge = 1;
+            else if (strcasecmp(opt, "nohuge") == 0) huge = 0;
+            else if ((size = mem_parse_size(opt)) == -1) {
+                Mostrar("Uso: ReiniciarMemoria [lista|buddy] [tamano[K|M|G]] [huge|nohuge]\n");
+                return 0;
+            }
+        }
+        // Solo huge: mismo tamaño de arena. Solo tamaño: mismo pedido de huge pages
+        if (size == -1 && huge != -1) size = mem_total();
+        if (size != -1 && mem_configure(size, huge) == -1) {
+            Mostrar("[ERROR] Tamano fuera de rango (%d bytes .. %lld GB)\n", MEM_MIN_SIZE, MEM_MAX_SIZE >> 30);
+            return 0;
+        }
+        slab_reset();        // Sus páginas dejan de existir
+        paging_shutdown();   // Y también el pool de marcos
+        tcache_reset();      // Y los spans de las cachés por hilo
+        if (mem_init_mode(mode) == -1)  // Descarta todas las asignaciones
+            Mostrar("[WARNING] No se pudo reservar la arena pedida; se conserva la anterior\n");
+        Mostrar("[OK] Memoria reiniciada en modo %s: %lld bytes%s\n", mode == MEM_MODE_BUDDY ? "buddy" : "lista",
+               mem_total(), mem_huge() ? " (huge pages)" : "");
+    }
+    else if (strcasecmp(cmd, "EstresMemoria") == 0) {
+        char *threads_s = strtok(NULL, " ");
+        char *ops_s = strtok(NULL, " ");
+        char *seed_s = strtok(NULL, " ");
+        if (!threads_s) { Mostrar("Uso: EstresMemoria <hilos> [ops_por_hilo] [semilla]\n"); return 0; }
+        int threads = atoi(threads_s);
+        long long ops = ops_s ? atoll(ops_s) : 200000;
+        unsigned long long seed = seed_s ? strtoull(seed_s, NULL, 10) : 42;
+        if (threads <= 0 || threads > 64 || ops <= 0) { Mostrar("[WARNING] Hilos entre 1 y 64 y operaciones > 0\n"); return 0; }
+
+        Mostrar("[INFO] Estres de memoria: 1..%d hilo(s), %lld operaciones por hilo, objetos de %d..%d bytes\n",
+               threads, ops, TCACHE_MIN_OBJ, TCACHE_MAX_OBJ);
+        Mostrar("Hilos\tCentral ops/s\tCache ops/s\tAcel.\tContencion central\tContencion cache\n");
+        double base = 0.0;
+        long long fails = 0;
+        TCacheStats cs;
+        for (int k = 1; k <= threads; ++k) {
+            long long f1, f2;
+            // Sin caché: cada operación toma el lock global de la memoria
+            double plain = tcache_stress(k, ops, 0, seed, &f1);
+            TCacheStats ps;
+            tcache_stats(&ps);
+            // Con caché: solo los lotes pasan por los locks centrales
+            double cached = tcache_stress(k, ops, 1, seed, &f2);
+            tcache_stats(&cs);
+            if (k == 1) base = cached;
+            fails += f1 + f2;
+            Mostrar("%d\t%.0f\t%.0f\t%.2fx\t%lld/%lld\t\t%lld/%lld\n", k, plain, cached,
+                   plain > 0 ? cached / plain : 0.0, ps.heap_contended, ps.heap_locks,
+                   cs.central_contended + cs.heap_contended, cs.central_locks + cs.heap_locks);
+            if (k == threads)
+                Mostrar("[INFO] Escalado con cache: %.2fx con %d hilo(s) respecto de 1\n", base > 0 ? cached / base : 0.0, k);
+        }
+        Mostrar("[INFO] Ultima corrida con cache: %lld lote(s) pedidos, %lld devueltos, %lld span(s) de %d bytes\n",
+               cs.refills, cs.flushes, cs.spans, TCACHE_SPAN);
+        if (fails > 0)
+            Mostrar("[WARNING] %lld asignacion(es) fallaron: ampliar la memoria (ReiniciarMemoria <tamano>)\n", fails);
+    }
+    else if (strcasecmp(cmd, "EscribirMemoria") == 0) {
+        char *pid_s = strtok(NULL, " ");
+        char *blk_s = strtok(NULL, " ");
+        char *off_s = strtok(NULL, " ");
+        char *text = strtok(NULL, "");   // Resto de la línea
+        if (!pid_s || !blk_s || !off_s || !text) { Mostrar("Uso: EscribirMemoria <pid> <bloque> <offset> <texto>\n"); return 0; }
+        int rc = mem_write(atoi(pid_s), atoi(blk_s), atoll(off_s), text, (long long)strlen(text));
+        if (rc == MEM_ERR_BLOCK) Mostrar("[ERROR] El bloque %s no pertenece al PID=%s\n", blk_s, pid_s);
+        else if (rc == MEM_ERR_BOUNDS) Mostrar("[ERROR] Fuera de los limites del bloque %s\n", blk_s);
+        else if (rc != 0) Mostrar("[ERROR] No hay arena de memoria\n");
+        else Mostrar("[OK] %zu byte(s) escritos en el bloque %s\n", strlen(text), blk_s);
+    }
+    else if (strcasecmp(cmd, "LeerMemoria") == 0) {
+        char *pid_s = strtok(NULL, " ");
+        char *blk_s = strtok(NULL, " ");
+        char *off_s = strtok(NULL, " ");
+        char *n_s = strtok(NULL, " ");
+        if (!pid_s || !blk_s || !off_s || !n_s) { Mostrar("Uso: LeerMemoria <pid> <bloque> <offset> <n>\n"); return 0; }
+        long long n = atoll(n_s);
+        if (n <= 0 || n > 4096) { Mostrar("[WARNING] Se pueden leer de 1 a 4096 bytes por vez\n"); return 0; }
+        unsigned char buf[4097];
+        int rc = mem_read(atoi(pid_s), atoi(blk_s), atoll(off_s), buf, n);
+        if (rc == MEM_ERR_BLOCK) { Mostrar("[ERROR] El bloque %s no pertenece al PID=%s\n", blk_s, pid_s); return 0; }
+        if (rc == MEM_ERR_BOUNDS) { Mostrar("[ERROR] Fuera de los limites del bloque %s\n", blk_s); return 0; }
+        if (rc != 0) { Mostrar("[ERROR] No hay arena de memoria\n"); return 0; }
+        for (long long k = 0; k < n; ++k)
+            if (buf[k] < 32 || buf[k] > 126) buf[k] = '.';  // No imprimibles como '.'
+        buf[n] = '\0';
+        Mostrar("%s\n", (char *)buf);
+    }
+    else if (strcasecmp(cmd, "AnchoBandaMemoria") == 0) {
+        char *passes_s = strtok(NULL, " ");
+        int passes = passes_s ? atoi(passes_s) : 1;
+        if (passes <= 0) { Mostrar("Uso: AnchoBandaMemoria [pasadas]\n"); return 0; }
+        double wr, rd;
+        long long bytes = mem_bandwidth(passes, &wr, &rd);
+        if (bytes == 0) Mostrar("[WARNING] No hay bloques de procesos que recorrer\n");
+        else Mostrar("[INFO] %lld bytes de procesos x %d pasada(s): escritura %.2f GB/s, lectura %.2f GB/s\n",
+                    bytes, passes, wr, rd);
+    }
+    else if (strcasecmp(cmd, "CompactarMemoria") == 0) {
+        MemCompactResult r;
+        if (mem_compact(&r) == -1) { Mostrar("[WARNING] El modo buddy no admite compactacion\n"); return 0; }
+        Mostrar("[OK] Memoria compactada: %d bloque(s) movidos, %lld bytes, %lld ns\n",
+               r.moved_blocks, r.moved_bytes, r.ns);
+    }
+    else if (strcasecmp(cmd, "AutoCompactar") == 0) {
+        char *opt = strtok(NULL, " ");
+        if (!opt) {
+            Mostrar("[INFO] Compactacion automatica: %s\n", mem_auto_compact() ? "on" : "off");
+            Mostrar("Uso: AutoCompactar <on|off>\n");
+            return 0;
+        }
+        if (strcasecmp(opt, "on") == 0) mem_set_auto_compact(1);
+        else if (strcasecmp(opt, "off") == 0) mem_set_auto_compact(0);
+        else { Mostrar("Uso: AutoCompactar <on|off>\n"); return 0; }
+        Mostrar("[OK] Compactacion automatica: %s\n", mem_auto_compact() ? "on" : "off");
+    }
+    else if (strcasecmp(cmd, "Paginacion") == 0) {
+        char *frames_s = strtok(NULL, " ");
+        char *pol_s = strtok(NULL, " ");
+        char *sets_s = strtok(NULL, " ");
+        char *ways_s = strtok(NULL, " ");
+        if (!frames_s) { Mostrar("Uso: Paginacion <marcos|off> [fifo|lru|clock] [conjuntos] [vias]\n"); return 0; }
+        if (strcasecmp(frames_s, "off") == 0) {
+            paging_shutdown();
+            Mostrar("[OK] Paginacion desactivada (marcos devueltos a la memoria)\n");
+            return 0;
+        }
+        page_policy_t pol = PAGE_LRU;
+        if (pol_s) {
+            if (strcasecmp(pol_s, "fifo") == 0) pol = PAGE_FIFO;
+            else if (strcasecmp(pol_s, "lru") == 0) pol = PAGE_LRU;
+            else if (strcasecmp(pol_s, "clock") == 0) pol = PAGE_CLOCK;
+            else { Mostrar("Uso: Paginacion <marcos|off> [fifo|lru|clock] [conjuntos] [vias]\n"); return 0; }
+        }
+        long long nf;
+        if (parse_ll(frames_s, &nf) == -1 || nf <= 0 || nf > INT_MAX) {
+            Mostrar("Uso: Paginacion <marcos|off> [fifo|lru|clock] [conjuntos] [vias]\n");
+            return 0;
+        }
+        int frames = (int)nf;
+        if (paging_init(frames, pol, sets_s ? atoi(sets_s) : 0, ways_s ? atoi(ways_s) : 0) == -1)
+            Mostrar("[ERROR] No hay %lld bytes libres para %d marco(s) de %d bytes\n",
+                   (long long)frames * PAGE_SIZE, frames, PAGE_SIZE);
+        else
+            Mostrar("[OK] Paginacion %s con %d marco(s) de %d bytes\n", paging_policy_name(pol), frames, PAGE_SIZE);
+    }
+    else if (strcasecmp(cmd, "ReferenciasPaginas") == 0) {
+        char *path = strtok(NULL, " ");
+        if (!path) { Mostrar("Uso: ReferenciasPaginas <archivo>\n"); return 0; }
+        if (!paging_active()) { Mostrar("[WARNING] Primero crea los marcos con Paginacion <marcos>\n"); return 0; }
+        if (paging_run_file(path) == -1) Mostrar("[ERROR] No se pudo abrir %s\n", path);
+    }
+    else if (strcasecmp(cmd, "ReferenciasSinteticas") == 0) {
+        char *n_s = strtok(NULL, " ");
+        char *procs_s = strtok(NULL, " ");
+        char *pages_s = strtok(NULL, " ");
+        char *seed_s = strtok(NULL, " ");
+        if (!n_s || !procs_s || !pages_s) { Mostrar("Uso: ReferenciasSinteticas <n> <procesos> <paginas> [semilla]\n"); return 0; }
+        if (!paging_active()) { Mostrar("[WARNING] Primero crea los marcos con Paginacion <marcos>\n"); return 0; }
+        if (paging_run_synthetic(atoll(n_s), atoi(procs_s), atoi(pages_s), seed_s ? strtoull(seed_s, NULL, 10) : 1) == -1)
+            Mostrar("[ERROR] Parametros invalidos (n, procesos y paginas deben ser > 0)\n");
+    }
+    else if (strcasecmp(cmd, "CrearCache") == 0) {
+        char *name = strtok(NULL, " ");
+        char *size_s = strtok(NULL, " ");
+        if (!name || !size_s) { Mostrar("Uso: CrearCache <nombre> <tamano_objeto>\n"); return 0; }
+        int id = slab_create(name, atoi(size_s));
+        if (id == -1) Mostrar("[ERROR] No se pudo crear la cache (nombre repetido, tamano fuera de 1..%d o limite de %d caches)\n",
+                              SLAB_PAGE, SLAB_MAX_CACHES);
+        else Mostrar("[OK] Cache %s creada (id=%d)\n", name, id);
+    }
+    else if (strcasecmp(cmd, "AsignarObjeto") == 0) {
+        char *name = strtok(NULL, " ");
+        if (!name) { Mostrar("Uso: AsignarObjeto <cache>\n"); return 0; }
+        int id = slab_find(name);
+        long long addr = 0;
+        if (id == -1) { Mostrar("[WARNING] Cache no encontrada: %s\n", name); return 0; }
+        int obj = slab_alloc(id, &addr);
+        if (obj == -1) Mostrar("[ERROR] Sin memoria para una pagina slab nueva\n");
+        else Mostrar("[OK] Objeto %d de %s en la direccion %lld\n", obj, name, addr);
+    }
+    else if (strcasecmp(cmd, "LiberarObjeto") == 0) {
+        char *name = strtok(NULL, " ");
+        char *obj_s = strtok(NULL, " ");
+        if (!name || !obj_s) { Mostrar("Uso: LiberarObjeto <cache> <id_objeto>\n"); return 0; }
+        int id = slab_find(name);
+        if (id == -1) { Mostrar("[WARNING] Cache no encontrada: %s\n", name); return 0; }
+        if (slab_free(id, atoi(obj_s)) == -1) Mostrar("[WARNING] El objeto %s no esta asignado en %s\n", obj_s, name);
+        else Mostrar("[OK] Objeto %s liberado\n", obj_s);
+    }
+    else if (strcasecmp(cmd, "DestruirCache") == 0) {
+        char *name = strtok(NULL, " ");
+        if (!name) { Mostrar("Uso: DestruirCache <cache>\n"); return 0; }
+        int left = slab_destroy(slab_find(name));
+        if (left == -1) Mostrar("[WARNING] Cache no encontrada: %s\n", name);
+        else if (left > 0) Mostrar("[WARNING] Cache %s destruida con %d objeto(s) en uso\n", name, left);
+        else Mostrar("[OK] Cache %s destruida\n", name);
+    }
 
      // =============================
     //  Bloque de Archivos (VFS)
@@ -170,14 +638,47 @@ int shell_handle_line(char *line)
         else Mostrar("[OK] Archivo creado: %s\n", name);
     }
     else if (strcasecmp(cmd, "ListarArchivos") == 0) {
-        fs_ls();
+        char *path = strtok(NULL, " ");   // Opcional: por defecto el directorio actual
+        if (fs_ls(path) == -1) Mostrar("[WARNING] Ruta no encontrada: %s\n", path);
+    }
+    else if (strcasecmp(cmd, "CrearDirectorio") == 0) {
+        char *path = strtok(NULL, " ");
+        if (!path) { Mostrar("Uso: CrearDirectorio <ruta>\n"); return 0; }
+        if (fs_mkdir(path) == -1) Mostrar("[WARNING] No se pudo crear (ya existe, falta el padre o espacio lleno)\n");
+        else Mostrar("[OK] Directorio creado: %s\n", path);
+    }
+    else if (strcasecmp(cmd, "EliminarDirectorio") == 0) {
+        char *path = strtok(NULL, " ");
+        if (!path) { Mostrar("Uso: EliminarDirectorio <ruta>\n"); return 0; }
+        if (fs_rmdir(path) == -1) Mostrar("[WARNING] No se pudo eliminar (no existe, no esta vacio o es el actual)\n");
+        else Mostrar("[OK] Directorio eliminado: %s\n", path);
+    }
+    else if (strcasecmp(cmd, "CambiarDirectorio") == 0) {
+        char *path = strtok(NULL, " ");
+        if (!path) { Mostrar("Uso: CambiarDirectorio <ruta>\n"); return 0; }
+        char cwd[FS_MAX_PATH];
+        if (fs_chdir(path) == -1) Mostrar("[WARNING] Directorio no encontrado: %s\n", path);
+        else if (fs_getcwd(cwd, sizeof(cwd)) == 0) Mostrar("[OK] Directorio actual: %s\n", cwd);
+    }
+    else if (strcasecmp(cmd, "DirectorioActual") == 0) {
+        char cwd[FS_MAX_PATH];
+        if (fs_getcwd(cwd, sizeof(cwd)) == 0) Mostrar("%s\n", cwd);
     }
     else if (strcasecmp(cmd, "MostrarContenido") == 0) {
         char *name = strtok(NULL, " ");
         if (!name) { Mostrar("Uso: MostrarContenido <name>\n"); return 0; }
-        char buf[MAX_CONTENT];
-        if (fs_read(name, buf, sizeof(buf)) == -1) Mostrar("[WARNING] Archivo no encontrado\n");
-        else Mostrar("Contenido de %s:\n%s\n", name, buf);
+        if (fs_size(name) == -1) { Mostrar("[WARNING] Archivo no encontrado\n"); return 0; }
+        Mostrar("Contenido de %s:\n", name);
+        // El archivo puede medir megabytes: se lee por trozos (Mostrar corta a 4 KB)
+        char buf[2049];
+        long long got;
+        for (long long off = 0; (got = fs_pread(name, buf, 2048, off)) > 0; off += got) {
+            long long keep = utf8_cut(buf, got);
+            if (got == 2048 && keep > 0) got = keep;   // El carácter partido va en el próximo trozo
+            printable(buf, got);
+            Mostrar("%s", buf);
+        }
+        Mostrar("\n");
     }
     else if (strcasecmp(cmd, "EscribirArchivo") == 0) {
         char *name = strtok(NULL, " ");
@@ -190,8 +691,60 @@ int shell_handle_line(char *line)
         if (!rest) { Mostrar("[INFO] Escriba el contenido en la misma linea. Ej:\n");
                      Mostrar("       EscribirArchivo notas Hola mundo\n"); return 0; }
 
-        fs_write(name, rest);
-        Mostrar("[OK] Contenido escrito en %s\n", name);
+        if (fs_write(name, rest) == -1) Mostrar("[ERROR] Sin espacio para el contenido de %s\n", name);
+        else Mostrar("[OK] Contenido escrito en %s\n", name);
+    }
+    else if (strcasecmp(cmd, "AnexarArchivo") == 0) {
+        char *name = strtok(NULL, " ");
+        char *rest = strtok(NULL, "");   // Resto de la línea
+        if (!name || !rest) { Mostrar("Uso: AnexarArchivo <name> <texto>\n"); return 0; }
+        if (fs_find(name) == -1 && fs_mkfile(name) == -1) { Mostrar("[WARNING] No se pudo crear archivo\n"); return 0; }
+        long long n = (long long)strlen(rest);
+        // Solo se copian los bytes nuevos (más el salto de línea)
+        if (fs_append(name, rest, n) == -1 || fs_append(name, "\n", 1) == -1)
+            Mostrar("[ERROR] Sin espacio para anexar a %s\n", name);
+        else Mostrar("[OK] %lld byte(s) anexados a %s (tamano %lld)\n", n + 1, name, fs_size(name));
+    }
+    else if (strcasecmp(cmd, "LeerArchivo") == 0) {
+        char *name = strtok(NULL, " ");
+        char *off_s = strtok(NULL, " ");
+        char *n_s = strtok(NULL, " ");
+        long long off, n;
+        if (!name || !off_s || !n_s || parse_ll(off_s, &off) == -1 || parse_ll(n_s, &n) == -1) {
+            Mostrar("Uso: LeerArchivo <name> <offset> <n>\n");
+            return 0;
+        }
+        if (off < 0 || n <= 0 || n > 4096) { Mostrar("[WARNING] Offset >= 0 y de 1 a 4096 bytes por vez\n"); return 0; }
+        char buf[4097];
+        long long got = fs_pread(name, buf, n, off);
+        if (got == -1) { Mostrar("[WARNING] Archivo no encontrado\n"); return 0; }
+        printable(buf, got);   // Caracteres de control como '.'
+        Mostrar("[INFO] %lld byte(s) de %s desde %lld:\n%s\n", got, name, off, buf);
+    }
+    else if (strcasecmp(cmd, "EscribirEnArchivo") == 0) {
+        char *name = strtok(NULL, " ");
+        char *off_s = strtok(NULL, " ");
+        char *rest = strtok(NULL, "");
+        long long off;
+        if (!name || !off_s || !rest || parse_ll(off_s, &off) == -1) {
+            Mostrar("Uso: EscribirEnArchivo <name> <offset> <texto>\n");
+            return 0;
+        }
+        if (off < 0) { Mostrar("[WARNING] Offset invalido\n"); return 0; }
+        if (fs_pwrite(name, rest, (long long)strlen(rest), off) == -1)
+            Mostrar("[WARNING] Archivo no encontrado o sin espacio\n");
+        else Mostrar("[OK] %zu byte(s) escritos en %s desde %lld (tamano %lld)\n", strlen(rest), name, off, fs_size(name));
+    }
+    else if (strcasecmp(cmd, "TruncarArchivo") == 0) {
+        char *name = strtok(NULL, " ");
+        char *size_s = strtok(NULL, " ");
+        long long size;
+        if (!name || !size_s || parse_ll(size_s, &size) == -1) {
+            Mostrar("Uso: TruncarArchivo <name> <tamano>\n");
+            return 0;
+        }
+        if (fs_truncate(name, size) == -1) Mostrar("[WARNING] Archivo no encontrado o tamano invalido\n");
+        else Mostrar("[OK] %s ahora mide %lld byte(s)\n", name, size);
     }
     else if (strcasecmp(cmd, "EliminarArchivo") == 0) {
         char *name = strtok(NULL, " ");
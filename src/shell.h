@@ -1,6 +1,9 @@
 #ifndef SHELL_H
 #define SHELL_H
 
+// Opciones de arranque (--memoria <tamano>, --huge); antes de shell_init
+void shell_configure(int argc, char **argv);
+
 // Inicializa subsistemas y muestra banner de bienvenida
 void shell_init(void);
 
@@ -0,0 +1,138 @@
+#include <stdlib.h>     // Para realloc, free (cola de eventos dinámica)
+#include <time.h>       // Para nanosleep (modo de reloj REAL)
+#ifdef _WIN32
+#include <windows.h>    // Para Sleep() en Windows
+#endif
+#include "sim.h"        // Cabecera con SimEvent, modos de reloj, etc.
+
+// ======================================================
+// 📌 Variables globales
+// ======================================================
+static SimEvent *heap = NULL;      // Min-heap de eventos ordenado por (time, seq)
+static int heap_len = 0;           // Eventos pendientes
+static int heap_cap = 0;           // Capacidad reservada
+static long long now = 0;          // Instante virtual actual
+static long long next_seq = 0;     // Contador para desempatar eventos simultáneos
+
+static sim_clock_t clock_mode = SIM_CLOCK_REAL;  // Por defecto: comportamiento clásico
+static int ms_unit = SIM_DEFAULT_MS;             // Milisegundos por unidad en modo REAL
+
+// ======================================================
+// 📌 sleep_ms(ms)
+// Espera bloqueante en milisegundos (portable Windows/POSIX)
+// ======================================================
+static void sleep_ms(long long ms) {
+    if (ms <= 0) return;
+#ifdef _WIN32
+    Sleep((DWORD)ms);
+#else
+    struct timespec ts;
+    ts.tv_sec = (time_t)(ms / 1000);
+    ts.tv_nsec = (long)(ms % 1000) * 1000000L;
+    nanosleep(&ts, NULL);
+#endif
+}
+
+// Compara dos eventos: primero por instante, luego por orden de llegada
+static int ev_before(const SimEvent *a, const SimEvent *b) {
+    if (a->time != b->time) return a->time < b->time;
+    return a->seq < b->seq;
+}
+
+// ======================================================
+// 📌 sim_set_clock(mode, ms_per_unit)
+// Cambia entre reloj VIRTUAL (instantáneo) y REAL (limitado)
+// ======================================================
+void sim_set_clock(sim_clock_t mode, int ms_per_unit) {
+    clock_mode = mode;
+    if (ms_per_unit > 0) ms_unit = ms_per_unit;
+}
+
+sim_clock_t sim_clock_mode(void) { return clock_mode; }
+int sim_ms_per_unit(void) { return ms_unit; }
+long long sim_now(void) { return now; }
+int sim_pending(void) { return heap_len; }
+
+// ======================================================
+// 📌 sim_clear()
+// Descarta los eventos pendientes (el reloj se conserva)
+// ======================================================
+void sim_clear(void) {
+    heap_len = 0;
+}
+
+// ======================================================
+// 📌 sim_schedule(delay, kind, arg)
+// Inserta un evento en el heap: O(log E)
+// ======================================================
+int sim_schedule(long long delay, int kind, int arg) {
+    if (heap_len == heap_cap) {
+        int ncap = heap_cap ? heap_cap * 2 : 64;
+        SimEvent *nh = realloc(heap, (size_t)ncap * sizeof(SimEvent));
+        if (!nh) return -1;
+        heap = nh;
+        heap_cap = ncap;
+    }
+
+    SimEvent ev;
+    ev.time = now + (delay > 0 ? delay : 0);
+    ev.seq = next_seq++;
+    ev.kind = kind;
+    ev.arg = arg;
+
+    // Subir (sift-up) hasta restaurar la propiedad de heap
+    int i = heap_len++;
+    while (i > 0) {
+        int parent = (i - 1) / 2;
+        if (!ev_before(&ev, &heap[parent])) break;
+        heap[i] = heap[parent];
+        i = parent;
+    }
+    heap[i] = ev;
+    return 0;
+}
+
+// ======================================================
+// 📌 sim_next(ev)
+// Extrae el evento más próximo y avanza el reloj: O(log E).
+// En modo REAL duerme (delta * ms_unit) antes de devolverlo.
+// ======================================================
+int sim_next(SimEvent *ev) {
+    if (heap_len == 0) return 0;
+
+    *ev = heap[0];
+    SimEvent last = heap[--heap_len];
+
+    // Bajar (sift-down) el último elemento desde la raíz
+    int i = 0;
+    for (;;) {
+        int child = 2 * i + 1;
+        if (child >= heap_len) break;
+        if (child + 1 < heap_len && ev_before(&heap[child + 1], &heap[child])) child++;
+        if (!ev_before(&heap[child], &last)) break;
+        heap[i] = heap[child];
+        i = child;
+    }
+    if (heap_len > 0) heap[i] = last;
+
+    // Avanzar el reloj (en modo REAL, limitar a tiempo de pared)
+    if (ev->time > now) {
+        if (clock_mode == SIM_CLOCK_REAL) sleep_ms((ev->time - now) * ms_unit);
+        now = ev->time;
+    }
+    return 1;
+}
+
+void sim_sleep_ms(long long ms) { sleep_ms(ms); }
+
+// ======================================================
+// 📌 sim_advance(units) / sim_wait_units(units)
+// Utilidades para planificadores que llevan su propio reloj
+// ======================================================
+void sim_advance(long long units) {
+    if (units > 0) now += units;
+}
+
+void sim_wait_units(long long units) {
+    if (clock_mode == SIM_CLOCK_REAL) sleep_ms(units * ms_unit);
+}
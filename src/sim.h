@@ -0,0 +1,72 @@
+#ifndef SIM_H
+#define SIM_H
+
+// =====================================================
+// 📌 Reloj de simulación y cola de eventos discretos
+// =====================================================
+
+// Modo del reloj:
+//  - VIRTUAL: el tiempo avanza al instante hasta el próximo evento
+//  - REAL:    cada unidad de tiempo espera 'ms_por_unidad' milisegundos
+typedef enum { SIM_CLOCK_VIRTUAL = 0, SIM_CLOCK_REAL = 1 } sim_clock_t;
+
+// Milisegundos por unidad en modo REAL por defecto (1 unidad = 1 segundo)
+#define SIM_DEFAULT_MS 1000
+
+// Tipos de evento que maneja el planificador
+typedef enum {
+    EV_TICK = 0,     // Termina una unidad de CPU del proceso en ejecución
+    EV_ARRIVAL = 1   // Llega un proceso de una traza o carga sintética
+} sim_event_kind_t;
+
+// =====================================================
+// 📌 Estructura de un evento
+// =====================================================
+typedef struct {
+    long long time;  // Instante virtual en que ocurre el evento
+    long long seq;   // Orden de inserción (desempata eventos simultáneos)
+    int kind;        // Tipo de evento (sim_event_kind_t)
+    int arg;         // Dato asociado (p.ej. índice del proceso)
+} SimEvent;
+
+// =====================================================
+// 📌 Funciones del reloj y la cola de eventos
+// =====================================================
+
+// Configura el modo del reloj. 'ms_per_unit' solo aplica al modo REAL
+void sim_set_clock(sim_clock_t mode, int ms_per_unit);
+
+// Devuelve el modo actual y los milisegundos por unidad
+sim_clock_t sim_clock_mode(void);
+int sim_ms_per_unit(void);
+
+// Instante virtual actual (unidades transcurridas desde el arranque)
+long long sim_now(void);
+
+// Vacía la cola de eventos pendientes (el reloj no retrocede)
+void sim_clear(void);
+
+// Programa un evento 'delay' unidades después del instante actual.
+// Devuelve 0 si tuvo éxito o -1 si no hay memoria.
+int sim_schedule(long long delay, int kind, int arg);
+
+// Extrae el evento más próximo y avanza el reloj hasta él.
+// En modo REAL espera el tiempo correspondiente antes de devolverlo.
+// Devuelve 1 si obtuvo un evento o 0 si la cola está vacía.
+int sim_next(SimEvent *ev);
+
+// Cantidad de eventos pendientes en la cola
+int sim_pending(void);
+
+// Espera 'ms' milisegundos de pared (p.ej. mientras la ejecución está en pausa)
+void sim_sleep_ms(long long ms);
+
+// Avanza el reloj 'units' sin esperar (tiempo ya consumido en otro lado,
+// p.ej. por los núcleos de la simulación SMP)
+void sim_advance(long long units);
+
+// Espera el tiempo de pared de 'units' unidades (solo en modo REAL).
+// Es segura desde cualquier hilo: no toca la cola de eventos
+void sim_wait_units(long long units);
+
+#endif // SIM_H
@@ -0,0 +1,260 @@
+#include <stdlib.h>     // Para realloc (pool de slabs dinámico)
+#include <string.h>     // Para strncpy, strcmp
+#include "slab.h"       // Cabecera con SLAB_PAGE, SLAB_MAX_CACHES, etc.
+#include "memory.h"     // Páginas tomadas de la memoria simulada
+#include "log.h"        // Módulo de logging
+
+#define SLAB_MAX_OBJS (SLAB_PAGE / SLAB_MIN_OBJ)  // Objetos por slab (máximo)
+#define OBJ_USED (-2)                             // Marca de objeto asignado
+
+// Listas de slabs de cada caché
+enum { SLAB_PARTIAL = 0, SLAB_FULL = 1, SLAB_EMPTY = 2, SLAB_LISTS = 3 };
+
+// ======================================================
+// 📌 Estructuras
+// ======================================================
+typedef struct {
+    int cache;                       // Caché dueña (-1 = slab sin usar)
+    int blk;                         // Bloque de memoria de la página
+    int inuse;                       // Objetos asignados
+    int free_head;                   // Primer objeto libre (-1 = ninguno)
+    int list;                        // Lista en la que está (SLAB_PARTIAL...)
+    int next, prev;                  // Enlaces dentro de esa lista
+    signed char free_next[SLAB_MAX_OBJS]; // Siguiente libre u OBJ_USED
+} Slab;
+
+typedef struct {
+    char name[SLAB_NAME_LEN];        // Nombre ("" = caché sin usar)
+    int obj_size;                    // Tamaño de cada objeto
+    int per_slab;                    // Objetos por página
+    int head[SLAB_LISTS];            // Primer slab de cada lista
+    int count[SLAB_LISTS];           // Slabs en cada lista
+    int inuse;                       // Objetos asignados en total
+} SlabCache;
+
+// ======================================================
+// 📌 Variables globales
+// ======================================================
+static SlabCache caches[SLAB_MAX_CACHES];
+static Slab *slabs = NULL;           // Pool de slabs (índices estables)
+static int slab_cap = 0;             // Slabs reservados en el pool
+static int slab_spare = -1;          // Slabs sin usar, encadenados por 'next'
+
+// ======================================================
+// 📌 Funciones auxiliares
+// ======================================================
+
+// Toma un slab libre del pool (duplica el pool si hace falta)
+static int slab_node_new(void) {
+    if (slab_spare == -1) {
+        int ncap = slab_cap ? slab_cap * 2 : 16;
+        Slab *ns = realloc(slabs, (size_t)ncap * sizeof(Slab));
+        if (!ns) return -1;
+        slabs = ns;
+        for (int i = ncap - 1; i >= slab_cap; --i) {
+            slabs[i].cache = -1;
+            slabs[i].next = slab_spare;
+            slab_spare = i;
+        }
+        slab_cap = ncap;
+    }
+    int s = slab_spare;
+    slab_spare = slabs[s].next;
+    return s;
+}
+
+static void slab_node_release(int s) {
+    slabs[s].cache = -1;
+    slabs[s].next = slab_spare;
+    slab_spare = s;
+}
+
+// Inserta el slab al frente de la lista 'l' de su caché: O(1)
+static void list_push(int s, int l) {
+    SlabCache *c = &caches[slabs[s].cache];
+    slabs[s].list = l;
+    slabs[s].prev = -1;
+    slabs[s].next = c->head[l];
+    if (c->head[l] != -1) slabs[c->head[l]].prev = s;
+    c->head[l] = s;
+    c->count[l]++;
+}
+
+// Quita el slab de la lista en la que está: O(1)
+static void list_remove(int s) {
+    SlabCache *c = &caches[slabs[s].cache];
+    int l = slabs[s].list;
+    if (slabs[s].prev != -1) slabs[slabs[s].prev].next = slabs[s].next;
+    else c->head[l] = slabs[s].next;
+    if (slabs[s].next != -1) slabs[slabs[s].next].prev = slabs[s].prev;
+    c->count[l]--;
+}
+
+// Lista que corresponde según la ocupación del slab
+static int list_for(int s) {
+    const SlabCache *c = &caches[slabs[s].cache];
+    if (slabs[s].inuse == 0) return SLAB_EMPTY;
+    return slabs[s].inuse == c->per_slab ? SLAB_FULL : SLAB_PARTIAL;
+}
+
+// Pide una página a la memoria simulada y la deja como slab vacío
+static int slab_grow(int cache) {
+    int blk = mem_alloc(MEM_OWNER_SLAB, SLAB_PAGE);
+    if (blk == -1) return -1;
+    int s = slab_node_new();
+    if (s == -1) { mem_free_block(blk); return -1; }
+
+    const SlabCache *c = &caches[cache];
+    slabs[s].cache = cache;
+    slabs[s].blk = blk;
+    slabs[s].inuse = 0;
+    slabs[s].free_head = 0;
+    for (int k = 0; k < c->per_slab; ++k)
+        slabs[s].free_next[k] = (signed char)(k + 1 < c->per_slab ? k + 1 : -1);
+    list_push(s, SLAB_EMPTY);
+    return s;
+}
+
+// Devuelve la página del slab a la memoria simulada
+static void slab_drop(int s) {
+    list_remove(s);
+    mem_free_block(slabs[s].blk);
+    slab_node_release(s);
+}
+
+static int valid_cache(int cache) {
+    return cache >= 0 && cache < SLAB_MAX_CACHES && caches[cache].name[0] != '\0';
+}
+
+// ======================================================
+// 📌 slab_create(name, obj_size)
+// ======================================================
+int slab_create(const char *name, int obj_size) {
+    if (!name || !name[0] || slab_find(name) != -1) return -1;
+    if (obj_size <= 0 || obj_size > SLAB_PAGE) return -1;
+    if (obj_size < SLAB_MIN_OBJ) obj_size = SLAB_MIN_OBJ;
+
+    for (int id = 0; id < SLAB_MAX_CACHES; ++id) {
+        SlabCache *c = &caches[id];
+        if (c->name[0] != '\0') continue;
+        strncpy(c->name, name, SLAB_NAME_LEN - 1);
+        c->name[SLAB_NAME_LEN - 1] = '\0';
+        c->obj_size = obj_size;
+        c->per_slab = SLAB_PAGE / obj_size;
+        for (int l = 0; l < SLAB_LISTS; ++l) {
+            c->head[l] = -1;
+            c->count[l] = 0;
+        }
+        c->inuse = 0;
+        return id;
+    }
+    return -1;
+}
+
+int slab_find(const char *name) {
+    for (int id = 0; id < SLAB_MAX_CACHES; ++id)
+        if (caches[id].name[0] != '\0' && strcmp(caches[id].name, name) == 0) return id;
+    return -1;
+}
+
+// ======================================================
+// 📌 slab_alloc(cache, addr)
+// Parcial primero, luego vacío; solo si no hay ninguno se pide
+// una página nueva a la memoria simulada
+// ======================================================
+int slab_alloc(int cache, long long *addr) {
+    if (!valid_cache(cache)) return -1;
+    SlabCache *c = &caches[cache];
+
+    int s = c->head[SLAB_PARTIAL];
+    if (s == -1) s = c->head[SLAB_EMPTY];
+    if (s == -1) s = slab_grow(cache);
+    if (s == -1) return -1;
+
+    int k = slabs[s].free_head;
+    slabs[s].free_head = slabs[s].free_next[k];
+    slabs[s].free_next[k] = OBJ_USED;
+    slabs[s].inuse++;
+    c->inuse++;
+
+    // Vacío → parcial, o parcial → lleno
+    int l = list_for(s);
+    if (l != slabs[s].list) {
+        list_remove(s);
+        list_push(s, l);
+    }
+    // La página puede haberse movido al compactar: dirección vía su bloque
+    if (addr) *addr = mem_block_start(slabs[s].blk) + k * c->obj_size;
+    return s * SLAB_MAX_OBJS + k;
+}
+
+// ======================================================
+// 📌 slab_free(cache, obj)
+// ======================================================
+int slab_free(int cache, int obj) {
+    if (!valid_cache(cache) || obj < 0) return -1;
+    int s = obj / SLAB_MAX_OBJS, k = obj % SLAB_MAX_OBJS;
+    if (s >= slab_cap || slabs[s].cache != cache || k >= caches[cache].per_slab) return -1;
+    if (slabs[s].free_next[k] != OBJ_USED) return -1; // Doble liberación
+
+    SlabCache *c = &caches[cache];
+    slabs[s].free_next[k] = (signed char)slabs[s].free_head;
+    slabs[s].free_head = k;
+    slabs[s].inuse--;
+    c->inuse--;
+
+    // Lleno → parcial, o parcial → vacío
+    int l = list_for(s);
+    if (l != slabs[s].list) {
+        list_remove(s);
+        if (l == SLAB_EMPTY && c->count[SLAB_EMPTY] >= SLAB_KEEP_EMPTY) {
+            // Ya hay slabs vacíos de reserva: la página vuelve a la memoria
+            mem_free_block(slabs[s].blk);
+            slab_node_release(s);
+        } else {
+            list_push(s, l);
+        }
+    }
+    return 0;
+}
+
+// ======================================================
+// 📌 slab_destroy(cache)
+// ======================================================
+int slab_destroy(int cache) {
+    if (!valid_cache(cache)) return -1;
+    SlabCache *c = &caches[cache];
+    int left = c->inuse;
+    for (int l = 0; l < SLAB_LISTS; ++l)
+        while (c->head[l] != -1) slab_drop(c->head[l]);
+    c->name[0] = '\0';
+    c->inuse = 0;
+    return left;
+}
+
+void slab_reset(void) {
+    for (int id = 0; id < SLAB_MAX_CACHES; ++id)
+        if (caches[id].name[0] != '\0') slab_destroy(id);
+}
+
+// ======================================================
+// 📌 slab_map()
+// Ocupación por caché: slabs en cada lista y bytes útiles
+// ======================================================
+void slab_map(void) {
+    int any = 0;
+    for (int id = 0; id < SLAB_MAX_CACHES; ++id) {
+        const SlabCache *c = &caches[id];
+        if (c->name[0] == '\0') continue;
+        if (!any) {
+            Mostrar("Caches slab (pagina %d bytes):\n", SLAB_PAGE);
+            Mostrar("Id\tCache\tObj\tPorSlab\tParcial\tLleno\tVacio\tEnUso\tUso\n");
+            any = 1;
+        }
+        int pages = c->count[SLAB_PARTIAL] + c->count[SLAB_FULL] + c->count[SLAB_EMPTY];
+        Mostrar("%d\t%s\t%d\t%d\t%d\t%d\t%d\t%d\t%.1f%%\n",
+               id, c->name, c->obj_size, c->per_slab,
+               c->count[SLAB_PARTIAL], c->count[SLAB_FULL], c->count[SLAB_EMPTY], c->inuse,
+               pages ? 100.0 * c->inuse * c->obj_size / ((double)pages * SLAB_PAGE) : 0.0);
+    }
+}
@@ -0,0 +1,51 @@
+#ifndef SLAB_H
+#define SLAB_H
+
+// =====================================================
+// 📌 Capa slab: cachés de objetos de tamaño fijo
+// =====================================================
+// Cada caché toma páginas de SLAB_PAGE bytes de la memoria
+// simulada (bloques con dueño MEM_OWNER_SLAB) y las reparte en
+// objetos iguales. Los slabs se agrupan en listas parcial, lleno
+// y vacío; asignar y liberar un objeto es O(1).
+
+// Tamaño de cada página (slab) tomada de la memoria simulada
+#define SLAB_PAGE 256
+
+// Tamaño mínimo de objeto (máximo SLAB_PAGE / SLAB_MIN_OBJ objetos por slab)
+#define SLAB_MIN_OBJ 8
+
+// Cantidad máxima de cachés simultáneas
+#define SLAB_MAX_CACHES 16
+
+// Longitud máxima del nombre de una caché
+#define SLAB_NAME_LEN 32
+
+// Slabs vacíos que cada caché conserva antes de devolver páginas
+#define SLAB_KEEP_EMPTY 1
+
+// Crea una caché para objetos de 'obj_size' bytes.
+// Devuelve su id o -1 (nombre repetido, tamaño inválido o sin espacio)
+int slab_create(const char *name, int obj_size);
+
+// Busca una caché por nombre. Devuelve su id o -1
+int slab_find(const char *name);
+
+// Asigna un objeto: O(1). Devuelve su id (>= 0) o -1 sin memoria.
+// Si 'addr' no es NULL recibe la dirección del objeto en la memoria
+int slab_alloc(int cache, long long *addr);
+
+// Libera un objeto por id: O(1). Devuelve 0 o -1 si no estaba asignado
+int slab_free(int cache, int obj);
+
+// Destruye la caché y devuelve sus páginas. Devuelve los objetos
+// que seguían en uso o -1 si la caché no existe
+int slab_destroy(int cache);
+
+// Destruye todas las cachés (p.ej. antes de reiniciar la memoria)
+void slab_reset(void);
+
+// Muestra la ocupación de cada caché (lo usa mem_map)
+void slab_map(void);
+
+#endif // SLAB_H
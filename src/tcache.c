@@ -0,0 +1,288 @@
+#include <stdlib.h>     // Para malloc, realloc, free
+#include <time.h>       // Para clock_gettime (duración del estrés)
+#include <pthread.h>    // Locks centrales e hilos de la prueba de estrés
+#include "tcache.h"     // Cabecera con TCACHE_SPAN, TCACHE_CLASSES, etc.
+#include "memory.h"     // Spans tomados de la memoria simulada
+
+#define TCACHE_CAP (2 * TCACHE_BATCH)   // Objetos por clase en la caché de un hilo
+#define STRESS_LIVE 64                  // Objetos vivos por hilo en el estrés
+
+// ======================================================
+// 📌 Estructuras
+// ======================================================
+typedef struct {
+    pthread_mutex_t lock;            // Protege la lista de esta clase
+    long long *objs;                 // Pila de objetos libres
+    int len, cap;
+} CentralList;
+
+struct TCache {
+    long long objs[TCACHE_CLASSES][TCACHE_CAP]; // Pilas de objetos libres por clase
+    int count[TCACHE_CLASSES];
+};
+
+// ======================================================
+// 📌 Variables globales
+// ======================================================
+static CentralList central[TCACHE_CLASSES];
+static pthread_once_t central_once = PTHREAD_ONCE_INIT;
+
+// Contadores (atómicos: los actualizan varios hilos)
+static long long central_locks = 0, central_contended = 0;
+static long long refills = 0, flushes = 0, spans = 0;
+static long long heap_locks0 = 0, heap_contended0 = 0; // Lock de la memoria al reiniciar
+
+// ======================================================
+// 📌 Funciones auxiliares
+// ======================================================
+
+// Crea los locks de las listas centrales (una sola vez)
+static void central_init(void) {
+    for (int c = 0; c < TCACHE_CLASSES; ++c) pthread_mutex_init(&central[c].lock, NULL);
+}
+
+// Clase de tamaño de un pedido (la menor que lo contiene)
+static int class_of(int size) {
+    int c = 0;
+    while ((TCACHE_MIN_OBJ << c) < size) c++;
+    return c;
+}
+
+static void count_add(long long *v, long long n) {
+    __atomic_add_fetch(v, n, __ATOMIC_RELAXED);
+}
+
+// Toma el lock de la clase contando si hubo contención
+static void central_enter(CentralList *cl) {
+    if (pthread_mutex_trylock(&cl->lock) != 0) {
+        count_add(&central_contended, 1);
+        pthread_mutex_lock(&cl->lock);
+    }
+    count_add(&central_locks, 1);
+}
+
+// Asegura lugar para 'n' objetos más en la lista central
+static int central_reserve(CentralList *cl, int n) {
+    if (cl->len + n <= cl->cap) return 0;
+    int ncap = cl->cap ? cl->cap : 256;
+    while (ncap < cl->len + n) ncap *= 2;
+    long long *no = realloc(cl->objs, (size_t)ncap * sizeof(long long));
+    if (!no) return -1;
+    cl->objs = no;
+    cl->cap = ncap;
+    return 0;
+}
+
+// Corta un span nuevo en objetos de la clase c (con el lock de la clase)
+static int central_grow(int c) {
+    CentralList *cl = &central[c];
+    int obj_size = TCACHE_MIN_OBJ << c, per_span = TCACHE_SPAN / obj_size;
+    if (central_reserve(cl, per_span) == -1) return -1;
+    int blk = mem_alloc(MEM_OWNER_TCACHE, TCACHE_SPAN);   // Lock de la memoria
+    if (blk == -1) return -1;
+    count_add(&spans, 1);
+    // Orden inverso: los objetos salen en direcciones crecientes
+    for (int k = per_span - 1; k >= 0; --k)
+        cl->objs[cl->len++] = (long long)blk * TCACHE_SPAN + (long long)k * obj_size;
+    return 0;
+}
+
+// Pasa hasta TCACHE_BATCH objetos de la lista central a la caché
+static int refill(TCache *tc, int c) {
+    CentralList *cl = &central[c];
+    central_enter(cl);
+    if (cl->len == 0) central_grow(c);
+    int n = cl->len < TCACHE_BATCH ? cl->len : TCACHE_BATCH;
+    for (int k = 0; k < n; ++k) tc->objs[c][tc->count[c]++] = cl->objs[--cl->len];
+    pthread_mutex_unlock(&cl->lock);
+    if (n > 0) count_add(&refills, 1);
+    return n;
+}
+
+// Devuelve 'n' objetos de la caché a la lista central.
+// Devuelve 0 o -1 si la lista no pudo crecer (no se mueve ninguno)
+static int flush(TCache *tc, int c, int n) {
+    CentralList *cl = &central[c];
+    central_enter(cl);
+    int rc = central_reserve(cl, n);
+    if (rc == 0)
+        for (int k = 0; k < n; ++k) cl->objs[cl->len++] = tc->objs[c][--tc->count[c]];
+    pthread_mutex_unlock(&cl->lock);
+    if (rc == 0) count_add(&flushes, 1);
+    return rc;
+}
+
+// Devuelve un solo objeto a la lista central (sin pasar por la caché)
+static int central_put(int c, long long obj) {
+    CentralList *cl = &central[c];
+    central_enter(cl);
+    int rc = central_reserve(cl, 1);
+    if (rc == 0) cl->objs[cl->len++] = obj;
+    pthread_mutex_unlock(&cl->lock);
+    return rc;
+}
+
+// ======================================================
+// 📌 tcache_create() / tcache_destroy(tc)
+// ======================================================
+TCache *tcache_create(void) {
+    pthread_once(&central_once, central_init);
+    TCache *tc = malloc(sizeof(TCache));
+    if (!tc) return NULL;
+    for (int c = 0; c < TCACHE_CLASSES; ++c) tc->count[c] = 0;
+    return tc;
+}
+
+// Lo que no entre en las listas centrales queda en sus spans hasta
+// el próximo tcache_reset
+void tcache_destroy(TCache *tc) {
+    if (!tc) return;
+    for (int c = 0; c < TCACHE_CLASSES; ++c)
+        if (tc->count[c] > 0 && flush(tc, c, tc->count[c]) == -1)
+            while (tc->count[c] > 0 && central_put(c, tc->objs[c][tc->count[c] - 1]) == 0)
+                tc->count[c]--;
+    free(tc);
+}
+
+// ======================================================
+// 📌 tcache_alloc(tc, size) / tcache_free(tc, obj, size)
+// Camino rápido sin locks: pop / push en la pila del hilo
+// ======================================================
+long long tcache_alloc(TCache *tc, int size) {
+    if (size <= 0 || size > TCACHE_MAX_OBJ) return -1;
+    int c = class_of(size);
+    if (tc->count[c] == 0 && refill(tc, c) == 0) return -1;
+    return tc->objs[c][--tc->count[c]];
+}
+
+int tcache_free(TCache *tc, long long obj, int size) {
+    if (obj < 0 || size <= 0 || size > TCACHE_MAX_OBJ) return -1;
+    int c = class_of(size);
+    // Pila llena: medio lote vuelve al centro; si no se pudo, el
+    // objeto va directo a la lista central
+    if (tc->count[c] == TCACHE_CAP && flush(tc, c, TCACHE_BATCH) == -1)
+        return central_put(c, obj);
+    tc->objs[c][tc->count[c]++] = obj;
+    return 0;
+}
+
+long long tcache_addr(long long obj) {
+    if (obj < 0) return -1;
+    int blk = (int)(obj / TCACHE_SPAN);
+    if (mem_block_owner(blk) != MEM_OWNER_TCACHE) return -1;
+    return mem_block_start(blk) + obj % TCACHE_SPAN;
+}
+
+// ======================================================
+// 📌 tcache_reset() / tcache_stats(st)
+// ======================================================
+
+// Vacía las listas centrales y devuelve los spans a la memoria
+static void central_release(void) {
+    for (int c = 0; c < TCACHE_CLASSES; ++c) {
+        free(central[c].objs);
+        central[c].objs = NULL;
+        central[c].len = central[c].cap = 0;
+    }
+    mem_free_by_owner(MEM_OWNER_TCACHE);
+}
+
+void tcache_reset(void) {
+    pthread_once(&central_once, central_init);
+    central_release();
+    central_locks = central_contended = 0;
+    refills = flushes = spans = 0;
+    mem_lock_stats(&heap_locks0, &heap_contended0);
+}
+
+void tcache_stats(TCacheStats *st) {
+    long long acq, cont;
+    mem_lock_stats(&acq, &cont);
+    st->central_locks = central_locks;
+    st->central_contended = central_contended;
+    st->heap_locks = acq - heap_locks0;
+    st->heap_contended = cont - heap_contended0;
+    st->refills = refills;
+    st->flushes = flushes;
+    st->spans = spans;
+}
+
+// ======================================================
+// 📌 tcache_stress(threads, ops, cached, seed, fails)
+// Cada hilo mantiene hasta STRESS_LIVE objetos vivos y en cada
+// operación asigna o libera uno al azar (xorshift64*)
+// ======================================================
+typedef struct {
+    pthread_t th;
+    long long ops;
+    int cached;
+    unsigned long long rng;
+    long long fails;
+} StressWorker;
+
+static unsigned long long stress_next(unsigned long long *s) {
+    *s ^= *s >> 12;
+    *s ^= *s << 25;
+    *s ^= *s >> 27;
+    return *s * 2685821657736338717ULL;
+}
+
+static void *stress_worker(void *arg) {
+    StressWorker *w = arg;
+    TCache *tc = w->cached ? tcache_create() : NULL;
+    long long live[STRESS_LIVE];
+    int lsize[STRESS_LIVE];
+    int n = 0;
+
+    for (long long op = 0; op < w->ops; ++op) {
+        unsigned long long r = stress_next(&w->rng);
+        if (n == 0 || (n < STRESS_LIVE && (r & 1))) {
+            int size = TCACHE_MIN_OBJ + (int)((r >> 8) % (TCACHE_MAX_OBJ - TCACHE_MIN_OBJ + 1));
+            long long obj = tc ? tcache_alloc(tc, size) : mem_alloc(MEM_OWNER_TCACHE, size);
+            if (obj == -1) { w->fails++; continue; }
+            live[n] = obj;
+            lsize[n++] = size;
+        } else {
+            int k = (int)((r >> 16) % (unsigned long long)n);
+            if (tc) tcache_free(tc, live[k], lsize[k]);
+            else mem_free_block((int)live[k]);
+            live[k] = live[--n];
+            lsize[k] = lsize[n];
+        }
+    }
+    while (n > 0) {
+        --n;
+        if (tc) tcache_free(tc, live[n], lsize[n]);
+        else mem_free_block((int)live[n]);
+    }
+    tcache_destroy(tc);
+    return NULL;
+}
+
+double tcache_stress(int threads, long long ops, int cached, unsigned long long seed, long long *fails) {
+    *fails = 0;
+    if (threads <= 0 || ops <= 0) return 0.0;
+    StressWorker *ws = calloc((size_t)threads, sizeof(StressWorker));
+    if (!ws) return 0.0;
+    tcache_reset();
+
+    struct timespec t0, t1;
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    int started = 0;
+    for (int k = 0; k < threads; ++k) {
+        ws[k].ops = ops;
+        ws[k].cached = cached;
+        ws[k].rng = (seed ? seed : 1) * (unsigned long long)(2 * k + 1);
+        if (pthread_create(&ws[k].th, NULL, stress_worker, &ws[k]) != 0) break;
+        started++;
+    }
+    for (int k = 0; k < started; ++k) pthread_join(ws[k].th, NULL);
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+
+    for (int k = 0; k < started; ++k) *fails += ws[k].fails;
+    free(ws);
+    central_release();   // Los spans vuelven a la memoria; los contadores quedan
+
+    double secs = (double)(t1.tv_sec - t0.tv_sec) + (double)(t1.tv_nsec - t0.tv_nsec) / 1e9;
+    return secs > 0 ? (double)started * (double)ops / secs : 0.0;
+}
@@ -0,0 +1,73 @@
+#ifndef TCACHE_H
+#define TCACHE_H
+
+// =====================================================
+// 📌 Cachés por hilo para objetos pequeños
+// =====================================================
+// Al estilo de tcmalloc / mimalloc: cada hilo tiene su caché con
+// una pila de objetos libres por clase de tamaño y asigna o libera
+// sin locks. Cuando una pila se vacía pide un lote a la lista
+// central de esa clase (con su propio lock); cuando se llena le
+// devuelve medio lote. Las listas centrales se llenan cortando
+// spans de la memoria simulada (dueño MEM_OWNER_TCACHE).
+//
+// Un objeto se identifica por span * TCACHE_SPAN + desplazamiento,
+// así sigue siendo válido aunque la compactación mueva el span.
+
+// Tamaño de cada span tomado de la memoria simulada
+#define TCACHE_SPAN 4096
+
+// Clases de tamaño: clase c = objetos de 16 << c bytes (16..256)
+#define TCACHE_CLASSES 5
+#define TCACHE_MIN_OBJ 16
+#define TCACHE_MAX_OBJ (TCACHE_MIN_OBJ << (TCACHE_CLASSES - 1))
+
+// Objetos que se mueven entre la caché de un hilo y la lista central
+#define TCACHE_BATCH 32
+
+// Caché de un hilo (opaca): cada hilo usa la suya
+typedef struct TCache TCache;
+
+// Contadores de contención
+typedef struct {
+    long long central_locks;     // Adquisiciones de los locks centrales
+    long long central_contended; // ...que encontraron el lock ocupado
+    long long heap_locks;        // Adquisiciones del lock de la memoria
+    long long heap_contended;    // ...que lo encontraron ocupado
+    long long refills;           // Lotes pedidos a las listas centrales
+    long long flushes;           // Lotes devueltos a las listas centrales
+    long long spans;             // Spans cortados de la memoria simulada
+} TCacheStats;
+
+// Crea / destruye la caché de un hilo. Al destruirla sus objetos
+// libres vuelven a las listas centrales
+TCache *tcache_create(void);
+void tcache_destroy(TCache *tc);
+
+// Asigna un objeto de 'size' bytes (1..TCACHE_MAX_OBJ).
+// Devuelve su id o -1 sin memoria
+long long tcache_alloc(TCache *tc, int size);
+
+// Libera un objeto; 'size' es el tamaño con el que se pidió.
+// Devuelve 0 o -1 si no pudo devolverse (sin memoria para la lista
+// central): queda reservado en su span hasta el próximo tcache_reset
+int tcache_free(TCache *tc, long long obj, int size);
+
+// Dirección actual del objeto en la memoria simulada (-1 si no es válido)
+long long tcache_addr(long long obj);
+
+// Vacía las listas centrales y devuelve los spans a la memoria.
+// Solo con todas las cachés destruidas (p.ej. antes de reiniciar)
+void tcache_reset(void);
+
+// Contadores acumulados desde el último tcache_reset
+void tcache_stats(TCacheStats *st);
+
+// Prueba de estrés: 'threads' hilos hacen 'ops' asignaciones y
+// liberaciones aleatorias cada uno (objetos de 16..TCACHE_MAX_OBJ
+// bytes). Con 'cached' usan sus cachés; si no, cada operación va
+// directo a mem_alloc / mem_free_block. Devuelve las operaciones
+// por segundo y deja en *fails las asignaciones fallidas
+double tcache_stress(int threads, long long ops, int cached, unsigned long long seed, long long *fails);
+
+#endif // TCACHE_H
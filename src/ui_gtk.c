@@ -2,22 +2,66 @@
 #include <string.h>
 #include "shell.h"
 #include "log.h"
+#include "process.h"   // Pausa/cancelación del planificador en curso
+
+// Refresco del terminal: ~60 cuadros por segundo
+#define UI_FRAME_MS 16
+// Bytes máximos que se pintan por cuadro (el resto espera al siguiente)
+#define UI_MAX_CHUNK (64 * 1024)
+// Caracteres que conserva el terminal (se descartan los más antiguos)
+#define UI_MAX_CHARS (2 * 1024 * 1024)
 
 // Variables globales para componentes de la GUI
 static GtkTextBuffer *BUF = NULL;     // Buffer del terminal de salida
 static GtkWidget *ENTRY = NULL;       // Campo de entrada de comandos
 static GtkWidget *STATUS = NULL;      // Barra de estado
 static GtkWidget *SCROLLED_WIN = NULL; // Ventana con scroll para auto-scroll
+static GtkWidget *B_PAUSE = NULL;     // Pausar / reanudar la ejecución
+static GtkWidget *B_CANCEL = NULL;    // Cancelar la ejecución
+
+// Los comandos corren en un hilo aparte para no congelar la ventana.
+// Su salida viaja por una cola y el hilo GTK la pinta por cuadros.
+static GAsyncQueue *OUTQ = NULL;      // Texto pendiente de pintar (cualquier hilo → GTK)
+static GThread *WORKER = NULL;        // Hilo del comando en curso
+static gboolean BUSY = FALSE;         // ¿Hay un comando ejecutándose? (solo hilo GTK)
 
 /* ---------- Utilidades GUI ---------- */
 
-// Función mejorada para enviar texto formateado al terminal de la GUI
+// Sink de salida: puede llamarse desde cualquier hilo, solo encola
 static void gui_sink(const char *text) {
+    g_async_queue_push(OUTQ, g_strdup(text));
+}
+
+// ======================================================
+// 📌 on_frame()
+// Temporizador del hilo GTK: junta lo encolado en un solo
+// bloque, lo inserta de una vez y desplaza la vista una vez
+// ======================================================
+static gboolean on_frame(gpointer data) {
+    (void)data;
+    GString *chunk = g_string_new(NULL);
+    char *piece;
+    while (chunk->len < UI_MAX_CHUNK && (piece = g_async_queue_try_pop(OUTQ))) {
+        g_string_append(chunk, piece);
+        g_free(piece);
+    }
+    if (chunk->len == 0) { g_string_free(chunk, TRUE); return G_SOURCE_CONTINUE; }
+
     GtkTextIter end;
     gtk_text_buffer_get_end_iter(BUF, &end);
 
     // Insertar el texto con mejor formato
-    gtk_text_buffer_insert(BUF, &end, text, -1);
+    gtk_text_buffer_insert(BUF, &end, chunk->str, (gint)chunk->len);
+    g_string_free(chunk, TRUE);
+
+    // Limitar el tamaño del terminal para que insertar siga siendo barato
+    gint chars = gtk_text_buffer_get_char_count(BUF);
+    if (chars > UI_MAX_CHARS) {
+        GtkTextIter start, cut;
+        gtk_text_buffer_get_start_iter(BUF, &start);
+        gtk_text_buffer_get_iter_at_offset(BUF, &cut, chars - UI_MAX_CHARS);
+        gtk_text_buffer_delete(BUF, &start, &cut);
+    }
 
     // Auto-scroll hacia abajo de manera más suave
     GtkTextMark *insert_mark = gtk_text_buffer_get_insert(BUF);
@@ -30,6 +74,7 @@ static void gui_sink(const char *text) {
     // Asegurar que el scroll llegue al final
     GtkAdjustment *adj = gtk_scrolled_window_get_vadjustment(GTK_SCROLLED_WINDOW(SCROLLED_WIN));
     gtk_adjustment_set_value(adj, gtk_adjustment_get_upper(adj) - gtk_adjustment_get_page_size(adj));
+    return G_SOURCE_CONTINUE;
 }
 
 // Actualiza el mensaje de la barra de estado
@@ -37,19 +82,54 @@ static void set_status(const char *msg) {
     gtk_label_set_text(GTK_LABEL(STATUS), msg);
 }
 
-// Ejecuta un comando y muestra su salida en el terminal
-static void run_command_str(const char *cmd) {
-    if (!cmd || !*cmd) return;
+// Habilita los controles de ejecución solo mientras hay un comando en curso
+static void update_controls(void) {
+    gtk_widget_set_sensitive(B_PAUSE, BUSY);
+    gtk_widget_set_sensitive(B_CANCEL, BUSY);
+    gtk_button_set_label(GTK_BUTTON(B_PAUSE), "⏸ Pausar");
+}
+
+// Fin del comando (vuelve al hilo GTK vía g_idle_add)
+static gboolean on_worker_done(gpointer data) {
+    g_thread_join(WORKER);
+    WORKER = NULL;
+    BUSY = FALSE;
+    update_controls();
+    if (GPOINTER_TO_INT(data)) gtk_main_quit(); // El comando fue "Salir"
+    else set_status("✅ Listo");
+    return G_SOURCE_REMOVE;
+}
+
+// Hilo de trabajo: ejecuta una línea del shell (puede tardar mucho)
+static gpointer worker_main(gpointer data) {
+    char line[1024];
+    g_strlcpy(line, data, sizeof line);
+    g_free(data);
+    int quit = shell_handle_line(line);
+    g_idle_add(on_worker_done, GINT_TO_POINTER(quit));
+    return NULL;
+}
+
+// Lanza un comando en el hilo de trabajo y muestra su salida en el terminal.
+// Devuelve FALSE si ya hay otro comando en ejecución
+static gboolean run_command_str(const char *cmd) {
+    if (!cmd || !*cmd) return FALSE;
+    if (BUSY) {
+        set_status("⏳ Hay un comando en ejecucion: espera, pausalo o cancelalo");
+        return FALSE;
+    }
 
     // Mostrar el comando en el terminal con formato
     gui_sink("\n🔹 CinnamStrawbOS> ");
     gui_sink(cmd);
     gui_sink("\n");
 
-    char line[1024];
-    g_strlcpy(line, cmd, sizeof line);
-    int quit = shell_handle_line(line);
-    if (quit) gtk_main_quit();
+    proc_sched_reset();   // Sin pausa ni cancelación de un comando anterior
+    BUSY = TRUE;
+    update_controls();
+    set_status("⚙️ Ejecutando...");
+    WORKER = g_thread_new("shell", worker_main, g_strdup(cmd));
+    return TRUE;
 }
 
 // Callback para el botón ejecutar
@@ -70,12 +150,32 @@ static gboolean on_entry_activate(GtkEntry *e, gpointer) {
 /* ---- Callbacks para botones de acceso rápido ---- */
 
 // Botones de la barra de herramientas para comandos frecuentes
-static void on_btn_help(GtkWidget*, gpointer)   { run_command_str("Ayuda"); set_status("📖 Mostrando ayuda"); }
-static void on_btn_listp(GtkWidget*, gpointer)  { run_command_str("ListarProcesos"); set_status("⚡ Listando procesos"); }
-static void on_btn_memmap(GtkWidget*, gpointer) { run_command_str("MostrarMapaMemoria"); set_status("💾 Mostrando mapa de memoria"); }
-static void on_btn_listfs(GtkWidget*, gpointer) { run_command_str("ListarArchivos"); set_status("📂 Listando archivos"); }
-static void on_btn_savefs(GtkWidget*, gpointer) { run_command_str("GuardarFS"); set_status("💾 VFS guardado"); }
-static void on_btn_loadfs(GtkWidget*, gpointer) { run_command_str("CargarFS"); set_status("📁 VFS cargado"); }
+static void on_btn_help(GtkWidget*, gpointer)   { if (run_command_str("Ayuda")) set_status("📖 Mostrando ayuda"); }
+static void on_btn_listp(GtkWidget*, gpointer)  { if (run_command_str("ListarProcesos")) set_status("⚡ Listando procesos"); }
+static void on_btn_memmap(GtkWidget*, gpointer) { if (run_command_str("MostrarMapaMemoria")) set_status("💾 Mostrando mapa de memoria"); }
+static void on_btn_listfs(GtkWidget*, gpointer) { if (run_command_str("ListarArchivos")) set_status("📂 Listando archivos"); }
+static void on_btn_savefs(GtkWidget*, gpointer) { if (run_command_str("GuardarFS")) set_status("💾 VFS guardado"); }
+static void on_btn_loadfs(GtkWidget*, gpointer) { if (run_command_str("CargarFS")) set_status("📁 VFS cargado"); }
+
+// Pausa o reanuda el planificador en curso (lo consulta en cada evento)
+static void on_btn_pause(GtkWidget*, gpointer) {
+    int paused = !proc_sched_paused();
+    proc_sched_pause(paused);
+    gtk_button_set_label(GTK_BUTTON(B_PAUSE), paused ? "▶ Reanudar" : "⏸ Pausar");
+    set_status(paused ? "⏸ Ejecucion en pausa" : "⚙️ Ejecutando...");
+}
+
+// Cancela el planificador: los procesos pendientes vuelven a la cola
+static void on_btn_cancel(GtkWidget*, gpointer) {
+    proc_sched_cancel();
+    set_status("⏹ Cancelando...");
+}
+
+// Al cerrar la ventana: cancelar lo que esté corriendo y salir
+static void on_destroy(GtkWidget*, gpointer) {
+    proc_sched_cancel();
+    gtk_main_quit();
+}
 
 // Callback para limpiar el terminal
 static void on_btn_clear(GtkWidget*, gpointer) {
@@ -207,7 +307,7 @@ int main(int argc, char **argv) {
     gtk_window_set_title(GTK_WINDOW(win), "CinnamStrawbOS");
     gtk_window_set_default_size(GTK_WINDOW(win), 1200, 800);
     gtk_window_set_position(GTK_WINDOW(win), GTK_WIN_POS_CENTER);
-    g_signal_connect(win, "destroy", G_CALLBACK(gtk_main_quit), NULL);
+    g_signal_connect(win, "destroy", G_CALLBACK(on_destroy), NULL);
 
     GtkWidget *root = gtk_box_new(GTK_ORIENTATION_VERTICAL, 0);
     gtk_container_add(GTK_CONTAINER(win), root);
@@ -239,6 +339,10 @@ int main(int argc, char **argv) {
     GtkWidget *b_savefs = gtk_button_new_with_label("💾 Guardar");
     GtkWidget *b_loadfs = gtk_button_new_with_label("📁 Cargar");
 
+    // Grupo Ejecución (activo solo mientras corre un comando)
+    B_PAUSE  = gtk_button_new_with_label("⏸ Pausar");
+    B_CANCEL = gtk_button_new_with_label("⏹ Cancelar");
+
     // Conectar callbacks
     g_signal_connect(b_help,   "clicked", G_CALLBACK(on_btn_help),   NULL);
     g_signal_connect(b_clear,  "clicked", G_CALLBACK(on_btn_clear),  NULL);
@@ -247,6 +351,8 @@ int main(int argc, char **argv) {
     g_signal_connect(b_listfs, "clicked", G_CALLBACK(on_btn_listfs), NULL);
     g_signal_connect(b_savefs, "clicked", G_CALLBACK(on_btn_savefs), NULL);
     g_signal_connect(b_loadfs, "clicked", G_CALLBACK(on_btn_loadfs), NULL);
+    g_signal_connect(B_PAUSE,  "clicked", G_CALLBACK(on_btn_pause),  NULL);
+    g_signal_connect(B_CANCEL, "clicked", G_CALLBACK(on_btn_cancel), NULL);
 
     // Organizar botones en grupos visuales
     gtk_box_pack_start(GTK_BOX(toolbar), b_help,   FALSE, FALSE, 0);
@@ -267,6 +373,13 @@ int main(int argc, char **argv) {
     gtk_box_pack_start(GTK_BOX(toolbar), b_savefs, FALSE, FALSE, 0);
     gtk_box_pack_start(GTK_BOX(toolbar), b_loadfs, FALSE, FALSE, 0);
 
+    // Separador visual
+    GtkWidget *sep3 = gtk_separator_new(GTK_ORIENTATION_VERTICAL);
+    gtk_box_pack_start(GTK_BOX(toolbar), sep3, FALSE, FALSE, 8);
+
+    gtk_box_pack_start(GTK_BOX(toolbar), B_PAUSE,  FALSE, FALSE, 0);
+    gtk_box_pack_start(GTK_BOX(toolbar), B_CANCEL, FALSE, FALSE, 0);
+
     /* Terminal de salida con diseño moderno */
     SCROLLED_WIN = gtk_scrolled_window_new(NULL, NULL);
     gtk_widget_set_name(SCROLLED_WIN, "terminal");
@@ -331,10 +444,13 @@ int main(int argc, char **argv) {
     gtk_box_pack_start(GTK_BOX(input_box), btn, FALSE, FALSE, 0);
 
     /* Configuración inicial del sistema */
+    OUTQ = g_async_queue_new_full(g_free);
+    g_timeout_add(UI_FRAME_MS, on_frame, NULL); // Pintar la salida encolada
     set_output(gui_sink);
     set_output_mode(LOG_MODE_GUI);
 
     // Mostrar mensaje de bienvenida en la interfaz GUI
+    shell_configure(argc, argv); // --memoria <tamano>, --huge
     shell_init();
     gui_sink("\n\n");
     gui_sink("╔══════════════════════════════════════════════════════════════╗\n");
@@ -352,7 +468,11 @@ int main(int argc, char **argv) {
     gtk_widget_grab_focus(ENTRY);
 
     gtk_widget_show_all(win);
+    update_controls();
     gtk_main();
+
+    // Esperar al comando en curso (ya se pidió cancelarlo)
+    if (WORKER) g_thread_join(WORKER);
     return 0;    
 }
 
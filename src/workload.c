@@ -0,0 +1,144 @@
+#include <stdio.h>      // Para fopen, fgets, fprintf (archivos de traza)
+#include <string.h>     // Para strcasecmp, strspn
+#include <math.h>       // Para log, pow (distribuciones)
+#include "workload.h"   // Cabecera del módulo
+#include "process.h"    // proc_submit (llegadas futuras)
+#include "log.h"        // Módulo de logging
+
+#ifdef _WIN32
+#define strcasecmp _stricmp // Compatibilidad con Windows
+#endif
+
+// ======================================================
+// 📌 Generador pseudoaleatorio reproducible
+// xorshift64* sembrado con splitmix64: la misma semilla da
+// la misma carga en cualquier plataforma (rand() no lo garantiza)
+// ======================================================
+typedef struct { unsigned long long s; } WlRng;
+
+static void rng_seed(WlRng *r, unsigned long long seed) {
+    unsigned long long z = seed + 0x9e3779b97f4a7c15ULL;
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    r->s = (z ^ (z >> 31)) | 1;   // Nunca cero
+}
+
+static unsigned long long rng_next(WlRng *r) {
+    r->s ^= r->s >> 12;
+    r->s ^= r->s << 25;
+    r->s ^= r->s >> 27;
+    return r->s * 0x2545f4914f6cdd1dULL;
+}
+
+// Uniforme en (0, 1]: nunca devuelve 0 (seguro para log y pow)
+static double rng_unit(WlRng *r) {
+    return ((rng_next(r) >> 11) + 1) * (1.0 / 9007199254740992.0);
+}
+
+// Exponencial de media 'mean'
+static double rng_exp(WlRng *r, double mean) {
+    return -mean * log(rng_unit(r));
+}
+
+// Entero uniforme en [lo, hi]
+static int rng_range(WlRng *r, int lo, int hi) {
+    return lo + (int)(rng_next(r) % (unsigned long long)(hi - lo + 1));
+}
+
+// ======================================================
+// 📌 Distribuciones de ráfaga
+// ======================================================
+typedef struct {
+    const char *name;             // Nombre del tipo de carga
+    double mean_burst;            // Ráfaga media aproximada (fija el intervalo)
+    int (*burst)(WlRng *r);       // Muestra una ráfaga
+} WlKind;
+
+// Exponencial de media 5 (mínimo 1 unidad)
+static int burst_poisson(WlRng *r) { return 1 + (int)rng_exp(r, 4.0); }
+
+// 80% trabajos cortos (1..4) y 20% largos (20..60)
+static int burst_bimodal(WlRng *r) {
+    return rng_next(r) % 5 ? rng_range(r, 1, 4) : rng_range(r, 20, 60);
+}
+
+// Pareto con xm=1 y alfa=1.5: la mayoría muy cortos, pocos enormes
+static int burst_pareto(WlRng *r) {
+    double x = 1.0 / pow(rng_unit(r), 1.0 / 1.5);
+    return x > WL_PARETO_CAP ? WL_PARETO_CAP : (int)x;
+}
+
+static const WlKind wl_kinds[] = {
+    { "poisson", 5.0,  burst_poisson },
+    { "bimodal", 10.0, burst_bimodal },
+    { "pareto",  3.0,  burst_pareto  },
+};
+
+// ======================================================
+// 📌 wl_load(path)
+// Lee la traza línea por línea y registra cada llegada
+// ======================================================
+int wl_load(const char *path) {
+    FILE *f = fopen(path, "r");
+    if (!f) return -1;
+
+    char line[256];
+    int count = 0, lineno = 0;
+    while (fgets(line, sizeof(line), f)) {
+        lineno++;
+        char *p = line + strspn(line, " \t");
+        if (*p == '#' || *p == '\n' || *p == '\r' || *p == '\0') continue;
+
+        long long at;
+        char name[32];
+        int burst, mem = 0;
+        if (sscanf(p, "%lld %31s %d %d", &at, name, &burst, &mem) < 3 || at < 0) {
+            Mostrar("[WARNING] %s:%d: linea invalida (se espera: llegada nombre rafaga [memoria])\n",
+                   path, lineno);
+            continue;
+        }
+        if (proc_submit(at, name, burst, mem) == -1) {
+            Mostrar("[ERROR] Sin memoria para las llegadas (%d cargadas)\n", count);
+            break;
+        }
+        count++;
+    }
+    fclose(f);
+    return count;
+}
+
+// ======================================================
+// 📌 wl_generate(kind, n, seed, path)
+// Intervalos exponenciales de media ráfaga/WL_LOAD (llegadas
+// Poisson) y memoria en potencias de 2 entre 16 y 256 bytes
+// ======================================================
+int wl_generate(const char *kind, int n, unsigned long long seed, const char *path) {
+    const WlKind *k = NULL;
+    for (size_t i = 0; i < sizeof(wl_kinds) / sizeof(wl_kinds[0]); ++i)
+        if (strcasecmp(kind, wl_kinds[i].name) == 0) k = &wl_kinds[i];
+    if (!k || n <= 0) return -1;
+
+    FILE *f = NULL;
+    if (path) {
+        f = fopen(path, "w");
+        if (!f) return -1;
+        fprintf(f, "# Carga %s: %d llegadas, semilla %llu\n", k->name, n, seed);
+        fprintf(f, "# llegada nombre rafaga memoria\n");
+    }
+
+    WlRng r;
+    rng_seed(&r, seed);
+    double gap = k->mean_burst / WL_LOAD;
+    double t = 0.0;
+    for (int i = 0; i < n; ++i) {
+        char name[32];
+        snprintf(name, sizeof(name), "%.3s%d", k->name, i);
+        int burst = k->burst(&r);
+        int mem = 16 << rng_range(&r, 0, 4);
+        if (f) fprintf(f, "%lld %s %d %d\n", (long long)t, name, burst, mem);
+        else if (proc_submit((long long)t, name, burst, mem) == -1) return -1;
+        t += rng_exp(&r, gap);
+    }
+    if (f && fclose(f) != 0) return -1;
+    return n;
+}
@@ -0,0 +1,29 @@
+#ifndef WORKLOAD_H
+#define WORKLOAD_H
+
+// =====================================================
+// 📌 Trazas de carga y generador sintético
+// =====================================================
+// Una traza es un archivo de texto con una llegada por línea:
+//     <llegada> <nombre> <rafaga> [memoria]
+// La llegada se mide en unidades desde el inicio de la ejecución.
+// Las líneas vacías o que empiezan con '#' se ignoran.
+
+// Carga media objetivo de las cargas sintéticas (ráfaga media / intervalo medio)
+#define WL_LOAD 0.8
+
+// Ráfaga máxima de la distribución de cola pesada (Pareto)
+#define WL_PARETO_CAP 10000
+
+// Lee una traza y registra sus llegadas para el próximo planificador.
+// Devuelve la cantidad de llegadas o -1 si no se pudo abrir el archivo
+int wl_load(const char *path);
+
+// Genera 'n' llegadas con intervalos exponenciales (Poisson) y ráfagas
+// según 'kind': "poisson" (exponencial), "bimodal" (cortas/largas) o
+// "pareto" (cola pesada). La misma semilla produce la misma carga.
+// Si 'path' no es NULL la guarda como traza; si no, la registra.
+// Devuelve 'n' o -1 si el tipo no existe o falla la escritura
+int wl_generate(const char *kind, int n, unsigned long long seed, const char *path);
+
+#endif // WORKLOAD_H